@@ -7,13 +7,36 @@ endif
 
 TEMPLATE_FILES+=$(wildcard static/*) $(wildcard firmware/hot-cold-asset.mk)
 
+# files in COMPRESS_ASSETS are linked LZ4-packed instead of raw, see include/compressed_asset.h
+ASSET_FILES:=$(filter-out $(COMPRESS_ASSETS),$(ASSET_FILES))
+
 ASSET_OBJ=$(addprefix $(BINDIR)/, $(addsuffix .o, $(ASSET_FILES)) )
+COMPRESSED_ASSET_PACK=$(addprefix $(BINDIR)/, $(addsuffix .lz4, $(COMPRESS_ASSETS)) )
+COMPRESSED_ASSET_OBJ=$(addsuffix .o, $(COMPRESSED_ASSET_PACK))
 
-GETALLOBJ=$(sort $(call ASMOBJ,$1) $(call COBJ,$1) $(call CXXOBJ,$1)) $(ASSET_OBJ)
+GETALLOBJ=$(sort $(call ASMOBJ,$1) $(call COBJ,$1) $(call CXXOBJ,$1)) $(ASSET_OBJ) $(COMPRESSED_ASSET_OBJ)
 
 .SECONDEXPANSION:
 $(ASSET_OBJ): $$(patsubst bin/%,%,$$(basename $$@))
 	$(VV)mkdir -p $(BINDIR)/static
 	$(VV)mkdir -p $(BINDIR)/static.lib
 	@echo "ASSET $@"
-	$(VV)$(OBJCOPY) -I binary -O elf32-littlearm -B arm $^ $@
\ No newline at end of file
+	$(VV)$(OBJCOPY) -I binary -O elf32-littlearm -B arm $^ $@
+
+# the packer runs on the build machine
+HOSTCXX?=g++
+ASSET_PACK=$(BINDIR)/asset_pack
+
+$(ASSET_PACK): tools/asset_pack.cpp include/compressed_asset.h
+	$(VV)mkdir -p $(BINDIR)
+	$(call test_output_2,Building $@ ,$(HOSTCXX) -std=c++20 -O2 -I$(INCDIR) $< -o $@,$(OK_STRING))
+
+$(COMPRESSED_ASSET_PACK): $(BINDIR)/%.lz4: % $(ASSET_PACK)
+	$(VV)mkdir -p $(dir $@)
+	$(VV)$(ASSET_PACK) $< $@
+
+# objcopy names the symbols after the path it is given, run from $(BINDIR) so they come out as
+# _binary_static_<name>_lz4_start, the same as ASSET's with _lz4 added
+$(COMPRESSED_ASSET_OBJ): %.o: %
+	@echo "ASSET $@"
+	$(VV)cd $(BINDIR) && $(OBJCOPY) -I binary -O elf32-littlearm -B arm $(patsubst bin/%,%,$<) $(patsubst bin/%,%,$@)
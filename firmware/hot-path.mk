@@ -0,0 +1,44 @@
+# Hot path build mode, configured in the Makefile:
+#   make HOT_OPT=1     builds HOT_SRC files and HOT_PATH functions (include/hot_path.h) at
+#                      -O$(HOT_OPT_LEVEL); everything else, cold package included, stays at -Os
+#   make size-report   section sizes of the hot objects and the package, run it in both modes
+#                      to see what the speed costs in upload size
+HOT_OBJ=$(addprefix $(BINDIR)/,$(patsubst $(SRCDIR)/%,%.o,$(HOT_SRC)))
+
+HOT_CXXFLAGS=
+ifeq ($(HOT_OPT),1)
+# after MFLAGS on the command line, so this -O wins over -Os
+HOT_CXXFLAGS+=-O$(HOT_OPT_LEVEL)
+ifeq ($(HOT_NEON),1)
+# NEON is not IEEE compliant, gcc only vectorizes float loops onto it when allowed to reassociate.
+# Results can differ in the last bits from the -Os build
+HOT_CXXFLAGS+=-ftree-vectorize -funsafe-math-optimizations
+endif
+endif
+
+# objects remember which mode built them: switching HOT_OPT touches a new stamp, which is newer
+# than every object, so everything affected by the mode is rebuilt
+HOT_STAMP:=$(BINDIR)/.hot-opt-$(HOT_OPT)-$(HOT_OPT_LEVEL)-$(HOT_NEON)
+$(HOT_STAMP):
+	$(VV)mkdir -p $(BINDIR)
+	-$(VV)rm -f $(BINDIR)/.hot-opt-*
+	$(VV)touch $@
+
+$(call CXXOBJ,): $(HOT_STAMP)
+
+ifeq ($(HOT_OPT),1)
+# explicit rules take priority over common.mk's pattern rules. Same command plus HOT_CXXFLAGS
+$(HOT_OBJ): $(BINDIR)/%.o: $(SRCDIR)/% $(HOT_STAMP)
+	$(VV)mkdir -p $(dir $@)
+	-$(VV)mkdir -p $(DEPDIR)/$(dir $*)
+	$(call test_output_2,Compiled $< (-O$(HOT_OPT_LEVEL)) ,$(CXX) -c $(INCLUDE) -iquote"$(INCDIR)/$(dir $*)" $(CXXFLAGS) $(EXTRA_CXXFLAGS) $(HOT_CXXFLAGS) -MT $@ -MMD -MP -MF $(DEPDIR)/$*.d -o $@ $<,$(OK_STRING))
+endif
+
+.PHONY: size-report
+size-report: $(basename $(DEFAULT_BIN)).elf
+	@echo "Hot objects (HOT_OPT=$(HOT_OPT), HOT_OPT_LEVEL=$(HOT_OPT_LEVEL), HOT_NEON=$(HOT_NEON)):"
+	-$(VV)$(SIZETOOL) $(SIZEFLAGS) $(HOT_OBJ) $(SIZES_SED) $(SIZES_NUMFMT)
+	@echo "HOT_PATH functions (.text.hot_path bytes per object):"
+	-$(VV)for obj in $(call CXXOBJ,); do $(SIZETOOL) -A $$obj | awk -v obj=$$obj '$$1 == ".text.hot_path" { print "  " $$2 "\t" obj }'; done
+	@echo "Package:"
+	-$(VV)$(SIZETOOL) $(SIZEFLAGS) $< $(SIZES_SED) $(SIZES_NUMFMT)
@@ -0,0 +1,27 @@
+# Compiled-in log level, configured in the Makefile:
+#   make LOG_MIN_LEVEL=2   strips debug and info logging (include/fast_log.h)
+#   make log-size          builds the package at LOG_SIZE_LOW and LOG_SIZE_HIGH (default 0 and 2)
+#                          and prints both sizes and the difference
+LOG_SIZE_LOW?=0
+LOG_SIZE_HIGH?=2
+
+# objects remember which level built them, like the HOT_OPT stamp in hot-path.mk
+LOG_STAMP:=$(BINDIR)/.log-min-level-$(LOG_MIN_LEVEL)
+$(LOG_STAMP):
+	$(VV)mkdir -p $(BINDIR)
+	-$(VV)rm -f $(BINDIR)/.log-min-level-*
+	$(VV)touch $@
+
+$(call CXXOBJ,): $(LOG_STAMP)
+
+LOG_SIZE_ELF=$(basename $(DEFAULT_BIN)).elf
+
+.PHONY: log-size
+log-size:
+	$(VV)$(MAKE) --no-print-directory LOG_MIN_LEVEL=$(LOG_SIZE_LOW) $(LOG_SIZE_ELF)
+	$(VV)$(SIZETOOL) -B $(LOG_SIZE_ELF) | awk 'NR == 2 { print $$1 + $$2 }' > $(BINDIR)/.log-size-low
+	$(VV)$(MAKE) --no-print-directory LOG_MIN_LEVEL=$(LOG_SIZE_HIGH) $(LOG_SIZE_ELF)
+	$(VV)$(SIZETOOL) -B $(LOG_SIZE_ELF) | awk 'NR == 2 { print $$1 + $$2 }' > $(BINDIR)/.log-size-high
+	@awk -v low=$(LOG_SIZE_LOW) -v high=$(LOG_SIZE_HIGH) -v elf=$(LOG_SIZE_ELF) \
+		'NR == 1 { a = $$1 } NR == 2 { b = $$1 } END { printf "%s text+data:\n  LOG_MIN_LEVEL=%s %d bytes\n  LOG_MIN_LEVEL=%s %d bytes\n  difference %d bytes\n", elf, low, a, high, b, b - a }' \
+		$(BINDIR)/.log-size-low $(BINDIR)/.log-size-high
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "main.h"
+
+/*
+ * Counts every operator new and delete in the program, by competition phase and by task, and
+ * flags allocations made where there should be none.
+ *
+ * Wrap steady-state code in a NoAllocScope: an allocation on that task while it is open is a
+ * violation. The executor (executor.h) opens one around every job run after its first, and
+ * opcontrol() around each loop iteration. Violations are reported by a low rate check outside the
+ * allocator: an error in the log, and in LOUD mode a controller rumble as well.
+ *
+ * Only operator new is seen. Direct malloc() calls (newlib, LVGL's own pool) are not counted.
+ */
+
+enum class AllocPhase : uint8_t { INITIALIZE, AUTONOMOUS, OPCONTROL, DISABLED };
+
+constexpr size_t allocPhaseCount = 4;
+
+enum class AllocAlarm {
+    LOG, // an error in the log per violation
+    LOUD // and rumble the controller, for bench testing
+};
+
+struct AllocCounts {
+    uint32_t allocations = 0;
+    uint32_t frees = 0;
+    uint32_t bytes = 0; // total asked for, not what is live
+};
+
+struct AllocStats {
+    AllocCounts total;
+    AllocCounts phases[allocPhaseCount];
+    uint32_t violations = 0;
+    uint32_t tasks = 0; // tasks that have allocated
+};
+
+/**
+ * Allocations from now on count towards phase. Call at the top of each competition callback
+ */
+void setAllocPhase(AllocPhase phase);
+
+/**
+ * Allocations on the calling task while this is in scope are violations. Nests. what (a string
+ * literal) names the code in the report
+ */
+class NoAllocScope {
+    public:
+        explicit NoAllocScope(const char* what);
+        ~NoAllocScope();
+        NoAllocScope(const NoAllocScope&) = delete;
+        NoAllocScope& operator=(const NoAllocScope&) = delete;
+    private:
+        const char* previous;
+};
+
+/**
+ * Starts checking for new violations every periodMs (an executor job)
+ */
+void startAllocAudit(AllocAlarm alarm = AllocAlarm::LOG, uint32_t periodMs = 100);
+
+AllocStats getAllocStats();
+
+/**
+ * Prints counts per phase and per task, the violations, and every arena's use (arena.h)
+ */
+void printAllocReport();
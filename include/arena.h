@@ -0,0 +1,118 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+/*
+ * Fixed-size bump arenas for memory a subsystem needs for the whole run (queues, UI objects).
+ * Each arena is that subsystem's budget: it is carved out of static storage once, allocation is a
+ * pointer bump that never touches the heap, and nothing is freed until reset(). A request over
+ * budget returns nullptr and is counted, so an undersized budget shows up in printAllocReport()
+ * (alloc_audit.h) instead of quietly growing the heap. PROS-free.
+ *
+ * <h3> Example Usage </h3>
+ * @code
+ * static StaticArena<4096> uiArena("ui");
+ * Widget* widget = uiArena.create<Widget>(parent);
+ * @endcode
+ */
+
+class Arena {
+    public:
+        static constexpr size_t maxArenas = 8;
+
+        Arena(const char* name, void* buffer, size_t size)
+            : name(name),
+              base(static_cast<unsigned char*>(buffer)),
+              size(size) {
+            size_t index = arenaCount().fetch_add(1);
+            if (index < maxArenas) arenas()[index] = this;
+        }
+
+        Arena(const Arena&) = delete;
+        Arena& operator=(const Arena&) = delete;
+
+        /**
+         * size bytes aligned to align, or nullptr if the budget is used up. Safe from any task
+         */
+        void* allocate(size_t bytes, size_t align = alignof(std::max_align_t)) {
+            size_t offset = offsetUsed.load(std::memory_order_relaxed);
+            size_t start;
+            do {
+                start = (reinterpret_cast<uintptr_t>(base) + offset + align - 1) / align * align -
+                        reinterpret_cast<uintptr_t>(base);
+                if (start + bytes > size) {
+                    failures.fetch_add(1, std::memory_order_relaxed);
+                    failedBytes.fetch_add(bytes, std::memory_order_relaxed);
+                    return nullptr;
+                }
+            } while (!offsetUsed.compare_exchange_weak(offset, start + bytes, std::memory_order_relaxed));
+            return base + start;
+        }
+
+        /**
+         * Constructs a T in the arena, nullptr if it does not fit. Its destructor is never run
+         */
+        template <typename T, typename... Args> T* create(Args&&... args) {
+            void* memory = allocate(sizeof(T), alignof(T));
+            return memory == nullptr ? nullptr : new (memory) T(std::forward<Args>(args)...);
+        }
+
+        /**
+         * Frees everything at once. Nothing allocated from it may be used afterwards
+         */
+        void reset() { offsetUsed.store(0); }
+
+        bool owns(const void* memory) const {
+            const unsigned char* bytes = static_cast<const unsigned char*>(memory);
+            return bytes >= base && bytes < base + size;
+        }
+
+        size_t used() const { return offsetUsed.load(std::memory_order_relaxed); }
+
+        size_t capacity() const { return size; }
+
+        uint32_t failureCount() const { return failures.load(std::memory_order_relaxed); }
+
+        /** bytes asked for by the requests that did not fit */
+        size_t failureBytes() const { return failedBytes.load(std::memory_order_relaxed); }
+
+        static size_t count() {
+            size_t registered = arenaCount().load();
+            return registered < maxArenas ? registered : maxArenas;
+        }
+
+        static Arena& at(size_t index) { return *arenas()[index]; }
+
+        const char* const name;
+    private:
+        static std::atomic<size_t>& arenaCount() {
+            static std::atomic<size_t> registered = 0;
+            return registered;
+        }
+
+        static Arena** arenas() {
+            static Arena* registered[maxArenas] = {};
+            return registered;
+        }
+
+        unsigned char* const base;
+        const size_t size;
+        std::atomic<size_t> offsetUsed = 0;
+        std::atomic<uint32_t> failures = 0;
+        std::atomic<size_t> failedBytes = 0;
+};
+
+/**
+ * An arena with its storage inline, for static arenas
+ */
+template <size_t bytes> class StaticArena : public Arena {
+    public:
+        explicit StaticArena(const char* name)
+            : Arena(name, storage, bytes) {}
+    private:
+        alignas(std::max_align_t) unsigned char storage[bytes];
+};
@@ -1,8 +1,49 @@
+#pragma once
+
 #include "main.h"
 #include "lemlib/api.hpp"
+#include "coro.h"
+
+/* ROUTES */
+enum class AutonAction { MOVE, TURN, SCORE };
+
+/**
+ * One step of a route: moveToPoint(x, y), turnToHeading(x), or auton::score()
+ */
+struct AutonStep {
+  AutonAction action;
+  float x = 0;
+  float y = 0;
+  int timeout = 0;
+  lemlib::MoveToPointParams params = {};
+};
+
+constexpr AutonStep moveTo(float x, float y, int timeout, lemlib::MoveToPointParams params = {}) {
+  return {AutonAction::MOVE, x, y, timeout, params};
+}
+
+constexpr AutonStep turnTo(float heading, int timeout) { return {AutonAction::TURN, heading, 0, timeout}; }
+
+constexpr AutonStep score() { return {AutonAction::SCORE}; }
+
+struct AutonRoute {
+  const AutonStep* steps;
+  size_t count;
+};
+
+/**
+ * The routes autonomous() runs, in order. Also drawn on the dashboard's field map
+ */
+extern const AutonRoute autonRoutes[3];
 
-void scoreBlocks();
+/**
+ * Runs a route's steps in order, see auton_actions.h. A move followed by score() runs both at once,
+ * so the intake is already going while the robot backs into the goal. Stops early, returning
+ * false, if cancelled
+ */
+Action routeAction(const AutonRoute& route);
 
-void autonRouteOne();
-void autonRouteTwo();
-void autonRouteThree();
\ No newline at end of file
+/**
+ * The autonomous routine: every route in autonRoutes with a short pause between them
+ */
+Action matchAuton();
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "main.h"
+#include "lemlib/api.hpp"
+#include "coro.h"
+#include "path_planner.h"
+
+/*
+ * The robot's actions for coroutine autonomous routines (coro.h), and the loop that runs them.
+ *
+ * lemlib runs one chassis motion at a time and a new motion call blocks until the previous one
+ * ends, so the chassis actions wait (without blocking) for the chassis to be free before starting
+ * theirs. Chassis actions in a whenAll therefore take turns; mechanism actions run alongside them.
+ */
+
+namespace auton {
+/**
+ * Builds the action with makeAction() and runs it to its end on the calling task, waking parked
+ * actions every periodMs (runAction(), coro.h). Returns what it co_returned
+ */
+bool run(Action (*makeAction)(), uint32_t periodMs = 5);
+
+/**
+ * chassis.moveToPoint, done when the motion ends. Cancelling it cancels the motion
+ */
+Action moveToPoint(float x, float y, int timeout, lemlib::MoveToPointParams params = {});
+
+/**
+ * chassis.turnToHeading, done when the motion ends. Cancelling it cancels the motion
+ */
+Action turnToHeading(float heading, int timeout);
+
+/**
+ * Runs the top intake out for 3 s. Cancelling it stops the intake early
+ */
+Action score();
+
+/**
+ * Drives to (x, y) in odometry coordinates along a route planned around the field's elements
+ * (field_layout.h) and anything blocked with blockFieldArea(). A leg that ends well short of its
+ * point is taken as a blocked lane: the area just ahead is blocked and the rest is replanned, at
+ * most twice. False if cancelled or there is no route
+ */
+Action driveTo(float x, float y, float maxSpeed = 127);
+
+/**
+ * Keeps later driveTo() routes out of area, odometry coordinates. False if too much is blocked
+ */
+bool blockFieldArea(FieldRect area);
+} // namespace auton
@@ -0,0 +1,235 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+
+/*
+ * Double-buffered, block-aligned file logging, shared by the microSD logger (src/sd_logger.cpp)
+ * and its Linux stand-in (tools/sd_log_standin.cpp). Mutex is pros::Mutex on the brain and
+ * std::mutex on Linux.
+ *
+ * Producers copy into the active buffer under the lock and never touch the file. When the active
+ * buffer is exactly full it becomes pending and the other buffer takes over; a background task
+ * calls service() to write pending buffers. Every full write is bufferSize bytes at a
+ * bufferSize-aligned file offset, the fast path for the card. If both buffers are full the new
+ * data is dropped and counted, so a producer's cost is bounded by one memcpy.
+ *
+ * The file is only ever touched by the service task, never under the producers' lock: rotating
+ * to a new file switches to one opened ahead of time (once the current one is half full), and the
+ * old file is closed after the pending buffers are written. A partial flush writes the active
+ * buffer's bytes so far and seeks back, leaving them in the buffer: when it fills, the full
+ * write lands on the same aligned offset and overwrites them, so later writes stay aligned.
+ */
+
+struct BlockLogStats {
+    uint32_t bytesLogged = 0;
+    uint32_t bytesDropped = 0;
+    uint32_t bytesWritten = 0;
+    uint32_t writes = 0;
+    uint32_t writeErrors = 0;
+    uint16_t fileIndex = 0;
+};
+
+template <typename Mutex, size_t bufferSize = 8192> class BlockLog {
+        static_assert(bufferSize % 512 == 0, "buffers must be a whole number of 512 byte blocks");
+    public:
+        /**
+         * @param directory where files go, e.g. "/usd/" on the brain
+         * @param prefix files are named <prefix>_000.bin, <prefix>_001.bin, ...
+         * @param maxFileBytes start a new file once this many bytes are written, 0 for no limit
+         */
+        BlockLog(const char* directory, const char* prefix, uint32_t maxFileBytes = 0)
+            : directory(directory),
+              prefix(prefix),
+              maxFileBytes(maxFileBytes) {}
+
+        ~BlockLog() { close(); }
+
+        /**
+         * Opens the first unused file name. Call once before logging, files are per run
+         */
+        bool open() {
+            file = openUnused(fileIndex);
+            if (file == nullptr) return false;
+            fileBytes = 0;
+            {
+                std::lock_guard<Mutex> lock(mutex);
+                stats.fileIndex = fileIndex;
+            }
+            return true;
+        }
+
+        /**
+         * Copies data into the active buffer. Returns false if any of it was dropped
+         */
+        bool append(const void* data, size_t length) {
+            const uint8_t* bytes = static_cast<const uint8_t*>(data);
+            std::lock_guard<Mutex> lock(mutex);
+            while (length > 0) {
+                if (used[active] == bufferSize) {
+                    if (pending[!active]) {
+                        // both buffers are full, the writer has fallen behind
+                        stats.bytesDropped += length;
+                        return false;
+                    }
+                    pending[active] = true;
+                    active = !active;
+                }
+                size_t chunk = std::min(length, bufferSize - used[active]);
+                std::memcpy(buffers[active] + used[active], bytes, chunk);
+                used[active] += chunk;
+                bytes += chunk;
+                length -= chunk;
+                stats.bytesLogged += chunk;
+            }
+            return true;
+        }
+
+        /**
+         * Writes pending buffers. With flushPartial, also writes what the active buffer holds so far
+         * (it stays there, see above) and flushes the file, e.g. when the robot is disabled. Returns
+         * true if anything was written.
+         * Only one task may call this.
+         */
+        bool service(bool flushPartial = false) {
+            bool wrote = false;
+            for (int i = 0; i < 2; i++) {
+                int index;
+                {
+                    std::lock_guard<Mutex> lock(mutex);
+                    // oldest first: the inactive buffer filled before the active one
+                    if (pending[!active]) index = !active;
+                    else if (pending[active]) index = active;
+                    else break;
+                }
+                writeBuffer(index);
+                std::lock_guard<Mutex> lock(mutex);
+                used[index] = 0;
+                pending[index] = false;
+                wrote = true;
+            }
+            if (flushPartial) {
+                size_t length;
+                int index;
+                {
+                    std::lock_guard<Mutex> lock(mutex);
+                    index = active;
+                    // a buffer that filled since the loop above goes first, on the next call
+                    length = pending[0] || pending[1] ? 0 : used[active];
+                }
+                // producers only append past length, so these bytes hold still while written
+                if (length > partialWritten[index] && file != nullptr) {
+                    size_t written = fwrite(buffers[index], 1, length, file);
+                    fseek(file, -static_cast<long>(written), SEEK_CUR);
+                    std::lock_guard<Mutex> lock(mutex);
+                    stats.writes++;
+                    if (written > partialWritten[index]) stats.bytesWritten += written - partialWritten[index];
+                    if (written != length) stats.writeErrors++;
+                    partialWritten[index] = std::max(partialWritten[index], written);
+                    wrote = true;
+                }
+                if (file != nullptr) fflush(file);
+            }
+            if (rotated) {
+                rotated = false;
+                fclose(retired);
+                retired = nullptr;
+            }
+            // the next file is opened once this one is half full, so a short run creates no spare. A
+            // run that stops after that and before the rotation leaves the spare empty, close() removes it
+            if (spare == nullptr && maxFileBytes != 0 && fileBytes >= maxFileBytes / 2) spare = openUnused(spareIndex);
+            return wrote;
+        }
+
+        /**
+         * Closes the files and deletes the spare if nothing was written to it. Call from the
+         * service task, after a final service(true)
+         */
+        void close() {
+            if (file != nullptr) fclose(file);
+            if (retired != nullptr) fclose(retired);
+            if (spare != nullptr) {
+                fclose(spare);
+                char path[96];
+                makePath(path, sizeof(path), spareIndex);
+                remove(path);
+            }
+            file = spare = retired = nullptr;
+            rotated = false;
+        }
+
+        BlockLogStats getStats() {
+            std::lock_guard<Mutex> lock(mutex);
+            return stats;
+        }
+    private:
+        void makePath(char* path, size_t size, uint16_t index) const {
+            snprintf(path, size, "%s%s_%03u.bin", directory, prefix, index);
+        }
+
+        // the first name from nextIndex on that does not exist yet, created for writing
+        FILE* openUnused(uint16_t& index) {
+            char path[96];
+            for (; nextIndex < 1000; nextIndex++) {
+                makePath(path, sizeof(path), nextIndex);
+                FILE* existing = fopen(path, "rb");
+                if (existing != nullptr) {
+                    fclose(existing);
+                    continue;
+                }
+                index = nextIndex++;
+                return fopen(path, "wb");
+            }
+            return nullptr;
+        }
+
+        // one full buffer, at the aligned offset a partial flush of it may have left the file at
+        void writeBuffer(int index) {
+            if (file == nullptr) {
+                std::lock_guard<Mutex> lock(mutex);
+                stats.writeErrors++;
+                return;
+            }
+            size_t written = fwrite(buffers[index], 1, bufferSize, file);
+            fileBytes += written;
+            bool rotate = maxFileBytes != 0 && fileBytes >= maxFileBytes && spare != nullptr;
+            if (rotate) {
+                // the old file is closed after this pass's writes
+                retired = file;
+                file = spare;
+                spare = nullptr;
+                fileIndex = spareIndex;
+                fileBytes = 0;
+                rotated = true;
+            }
+            std::lock_guard<Mutex> lock(mutex);
+            stats.writes++;
+            if (written > partialWritten[index]) stats.bytesWritten += written - partialWritten[index];
+            partialWritten[index] = 0;
+            if (written != bufferSize) stats.writeErrors++;
+            stats.fileIndex = fileIndex;
+        }
+
+        const char* directory;
+        const char* prefix;
+        uint32_t maxFileBytes;
+        // the service task's own, producers never touch the files
+        FILE* file = nullptr;
+        FILE* spare = nullptr;
+        FILE* retired = nullptr;
+        bool rotated = false;
+        uint32_t fileBytes = 0;
+        uint16_t fileIndex = 0;
+        uint16_t spareIndex = 0;
+        uint16_t nextIndex = 0;
+        size_t partialWritten[2] = {0, 0}; // bytes of each buffer a partial flush already put on the card
+        Mutex mutex;
+        alignas(8) uint8_t buffers[2][bufferSize];
+        size_t used[2] = {0, 0};
+        bool pending[2] = {false, false};
+        int active = 0;
+        BlockLogStats stats;
+};
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "main.h"
+#define FMT_HEADER_ONLY
+#include "fmt/core.h"
+
+/**
+ * What a full buffer does with a new record
+ */
+enum class OverflowPolicy {
+    DROP_OLDEST, // evict queued records until the new one fits, for live data where fresh matters
+    DROP_NEWEST // reject the new record, for logs where the start of a burst matters
+};
+
+struct BufferStats {
+    uint32_t enqueued = 0; // records accepted
+    uint32_t dropped = 0; // records rejected or evicted
+    uint32_t flushed = 0; // records written out
+    uint32_t flushes = 0; // write calls
+    uint32_t queuedBytes = 0;
+    uint32_t highWaterBytes = 0; // most bytes ever queued at once
+};
+
+/**
+ * Fixed-memory replacement for lemlib::Buffer.
+ *
+ * Records are copied into one byte ring taken from the buffers arena (arena.h) at construction, so
+ * a burst can never grow the heap. A task wakes every rate milliseconds and hands everything
+ * queued (up to batchSize bytes) to the write function in a single call. Producers only hold the
+ * lock for a memcpy.
+ */
+class BoundedBuffer {
+    public:
+        using WriteFn = void (*)(const uint8_t* data, size_t length, void* context);
+
+        /**
+         * @param capacity bytes of queued data, including a 2 byte header per record
+         * @param write called from the buffer's task with each batch
+         */
+        BoundedBuffer(size_t capacity, OverflowPolicy policy, WriteFn write, void* context = nullptr,
+                      size_t batchSize = 1024);
+        ~BoundedBuffer();
+        BoundedBuffer(const BoundedBuffer&) = delete;
+        BoundedBuffer& operator=(const BoundedBuffer&) = delete;
+
+        /**
+         * Queues one record. Returns false if it was dropped
+         */
+        bool push(const void* data, size_t length);
+
+        /**
+         * Formats into a stack buffer and queues the result, nothing touches the heap
+         */
+        template <typename... T> bool print(fmt::format_string<T...> format, T&&... args) {
+            char text[256];
+            auto result = fmt::format_to_n(text, sizeof(text), format, std::forward<T>(args)...);
+            return push(text, result.size < sizeof(text) ? result.size : sizeof(text));
+        }
+
+        /**
+         * Writes out everything queued right now, from the calling task
+         */
+        void flush();
+
+        /**
+         * Set how often the task flushes, in milliseconds
+         */
+        void setRate(uint32_t rate) { this->rate = rate; }
+
+        BufferStats getStats();
+    private:
+        void taskLoop();
+        void read(size_t position, uint8_t* out, size_t length) const;
+        void write(size_t position, const uint8_t* data, size_t length);
+        // moves up to batchSize bytes of whole records into batch, returns the byte count
+        size_t takeBatch(uint32_t& records);
+
+        uint8_t* storage; // from the buffers arena, or the heap if it was full
+        uint8_t* batch;
+        size_t capacity;
+        size_t batchSize;
+        size_t head = 0; // oldest record
+        size_t used = 0;
+        uint32_t queuedRecords = 0;
+        OverflowPolicy policy;
+        WriteFn writeFn;
+        void* context;
+        BufferStats stats;
+        uint32_t rate = 10;
+        pros::Mutex mutex;
+        pros::Mutex flushMutex; // serializes flush() with the task's own flushes
+        pros::Task task;
+};
+
+/**
+ * A bounded buffer in front of stdout (drop newest, 8 KB)
+ */
+BoundedBuffer& boundedStdout();
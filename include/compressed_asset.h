@@ -0,0 +1,207 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include "lemlib/asset.hpp"
+
+/*
+ * LZ4-compressed static assets.
+ *
+ * Files listed in COMPRESS_ASSETS (Makefile) are packed at build time by tools/asset_pack.cpp
+ * and linked instead of the raw file:
+ *
+ *   ["LZ4A"][raw size u32][block size u32][block count u32][stored size u32 per block][blocks]
+ *
+ * Each block is an independent LZ4 block holding up to block size raw bytes, so a caller can
+ * stream one block at a time into its own buffer. A block whose stored size has the top bit set
+ * did not compress and is stored raw. All integers are little endian.
+ *
+ * LVGL can bundle LZ4, but lv_conf.h never sets LV_USE_LZ4_INTERNAL, so it takes its default of 0
+ * from lv_conf_internal.h and the prebuilt liblvgl is built without the decoder. Turning it on
+ * would mean rebuilding LVGL, so lz4DecompressBlock below is a small standalone decoder.
+ */
+
+constexpr uint32_t assetPackMagic = 0x41345A4C; // "LZ4A"
+constexpr size_t assetPackHeaderSize = 16;
+constexpr uint32_t assetPackRawBlock = 0x80000000;
+
+/**
+ * Decodes one LZ4 block. Returns the number of bytes written, or -1 if the block is corrupt or
+ * would overflow dst
+ */
+inline int lz4DecompressBlock(const uint8_t* src, size_t srcLength, uint8_t* dst, size_t dstCapacity) {
+    const uint8_t* in = src;
+    const uint8_t* inEnd = src + srcLength;
+    uint8_t* out = dst;
+    uint8_t* outEnd = dst + dstCapacity;
+    auto readLength = [&](size_t length) -> size_t {
+        if (length != 15) return length;
+        uint8_t byte;
+        do {
+            if (in >= inEnd) return SIZE_MAX;
+            byte = *in++;
+            length += byte;
+        } while (byte == 255);
+        return length;
+    };
+    while (in < inEnd) {
+        uint8_t token = *in++;
+        size_t literals = readLength(token >> 4);
+        if (literals == SIZE_MAX || literals > static_cast<size_t>(inEnd - in) ||
+            literals > static_cast<size_t>(outEnd - out))
+            return -1;
+        std::memcpy(out, in, literals);
+        in += literals;
+        out += literals;
+        if (in == inEnd) break; // the last sequence has no match
+        if (inEnd - in < 2) return -1;
+        size_t offset = in[0] | (in[1] << 8);
+        in += 2;
+        if (offset == 0 || offset > static_cast<size_t>(out - dst)) return -1;
+        size_t match = readLength(token & 15);
+        if (match == SIZE_MAX) return -1;
+        match += 4;
+        if (match > static_cast<size_t>(outEnd - out)) return -1;
+        // byte by byte: the match may overlap the bytes it is producing
+        const uint8_t* from = out - offset;
+        for (size_t i = 0; i < match; i++) out[i] = from[i];
+        out += match;
+    }
+    return static_cast<int>(out - dst);
+}
+
+/**
+ * A packed asset. Decompresses on first access to get(), or block by block with readNext() /
+ * readBlock() into a caller buffer without allocating
+ */
+class CompressedAsset {
+    public:
+        CompressedAsset(const uint8_t* data, size_t size)
+            : data(data),
+              packedSize(size) {}
+
+        /**
+         * True if the data is a pack this decoder understands and its block table is all there
+         */
+        bool valid() const {
+            return packedSize >= assetPackHeaderSize && read32(0) == assetPackMagic &&
+                   read32(12) <= (packedSize - assetPackHeaderSize) / 4;
+        }
+
+        /**
+         * Size once decompressed
+         */
+        size_t size() const { return valid() ? read32(4) : 0; }
+
+        size_t blockSize() const { return valid() ? read32(8) : 0; }
+
+        size_t blockCount() const { return valid() ? read32(12) : 0; }
+
+        /**
+         * Position of a block by block read, see readNext()
+         */
+        struct Cursor {
+                size_t index = 0;
+                size_t offset = 0; // of the block's stored bytes, 0 until the first read
+        };
+
+        /**
+         * Decompresses the cursor's block into out (at least blockSize() bytes) and moves to the
+         * next. Returns the bytes written, 0 after the last block, or -1 if the data is corrupt
+         */
+        int readNext(Cursor& cursor, uint8_t* out, size_t capacity) const {
+            if (!valid()) return -1;
+            size_t count = blockCount();
+            if (cursor.index >= count) return 0;
+            if (cursor.offset == 0) cursor.offset = blocksStart();
+            // a truncated or corrupt pack stops here instead of reading past its end
+            if (cursor.offset < blocksStart() || cursor.offset > packedSize) return -1;
+            uint32_t stored = read32(assetPackHeaderSize + cursor.index * 4);
+            size_t length = stored & ~assetPackRawBlock;
+            if (length > packedSize - cursor.offset) return -1;
+            const uint8_t* block = data + cursor.offset;
+            cursor.index++;
+            cursor.offset += length;
+            if (stored & assetPackRawBlock) {
+                if (length > capacity) return -1;
+                std::memcpy(out, block, length);
+                return static_cast<int>(length);
+            }
+            return lz4DecompressBlock(block, length, out, capacity);
+        }
+
+        /**
+         * Decompresses one block into out, for random access. Same results as readNext()
+         */
+        int readBlock(size_t index, uint8_t* out, size_t capacity) const {
+            if (!valid()) return -1;
+            Cursor cursor;
+            cursor.offset = blocksStart();
+            for (; cursor.index < index && cursor.index < blockCount(); cursor.index++) {
+                size_t length = read32(assetPackHeaderSize + cursor.index * 4) & ~assetPackRawBlock;
+                if (length > packedSize - cursor.offset) return -1;
+                cursor.offset += length;
+            }
+            return readNext(cursor, out, capacity);
+        }
+
+        /**
+         * The decompressed asset, e.g. for chassis.follow(). The first call decompresses into a heap
+         * buffer kept for the life of the program; make it from one task (e.g. at the start of
+         * autonomous) before sharing the result. buf is empty if the data is corrupt
+         */
+        asset& get() {
+            if (decompressed.buf != nullptr || !valid()) return decompressed;
+            size_t rawSize = size();
+            // null terminated, so text assets can also be used as C strings
+            storage.reset(new uint8_t[rawSize + 1]);
+            size_t written = 0;
+            Cursor cursor;
+            for (size_t i = 0; i < blockCount(); i++) {
+                int length = readNext(cursor, storage.get() + written, rawSize - written);
+                if (length < 0) {
+                    storage.reset();
+                    return decompressed;
+                }
+                written += length;
+            }
+            storage[written] = 0;
+            decompressed = {storage.get(), written};
+            return decompressed;
+        }
+    private:
+        // where the first block's stored bytes start, right after the table
+        size_t blocksStart() const { return assetPackHeaderSize + blockCount() * 4; }
+
+        uint32_t read32(size_t offset) const {
+            uint32_t value;
+            std::memcpy(&value, data + offset, 4);
+            return value;
+        }
+
+        const uint8_t* data;
+        size_t packedSize;
+        std::unique_ptr<uint8_t[]> storage;
+        asset decompressed = {nullptr, 0};
+};
+
+/**
+ * Like ASSET(x), for a file listed in COMPRESS_ASSETS. Declares a CompressedAsset named x;
+ * x.get() gives the same asset ASSET(x) would
+ */
+#define COMPRESSED_ASSET(x)                                                                                            \
+    extern "C" {                                                                                                       \
+    extern uint8_t _binary_static_##x##_lz4_start[], _binary_static_##x##_lz4_size[];                                  \
+    }                                                                                                                  \
+    static CompressedAsset x(_binary_static_##x##_lz4_start, (size_t)_binary_static_##x##_lz4_size)
+
+/**
+ * Like ASSET_LIB(x), for compressed files in static.lib
+ */
+#define COMPRESSED_ASSET_LIB(x)                                                                                        \
+    extern "C" {                                                                                                       \
+    extern uint8_t _binary_static_lib_##x##_lz4_start[], _binary_static_lib_##x##_lz4_size[];                          \
+    }                                                                                                                  \
+    static CompressedAsset x(_binary_static_lib_##x##_lz4_start, (size_t)_binary_static_lib_##x##_lz4_size)
@@ -0,0 +1,463 @@
+#pragma once
+
+#include <array>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <new>
+#include <utility>
+
+/*
+ * Coroutine actions for autonomous routines: many actions in flight on one task, each costing a
+ * small frame from a fixed pool instead of a pros::Task and its stack.
+ *
+ * An Action is a coroutine that co_returns true when it did what it was asked. It starts when
+ * awaited. Actions wait with sleepFor() and waitUntil(), which park them in the CoroScheduler;
+ * whoever runs the actions (auton::run, src/auton_actions.cpp) calls tick() every few
+ * milliseconds to wake them; runAction() is that loop for any clock. whenAll() and whenAny() run
+ * several actions at once.
+ *
+ * Cancellation: whenAny() cancels the actions that did not finish first, and withTimeout() is
+ * whenAny() against a sleep. A cancelled action's pending and later waits return false at once,
+ * so it runs to its end quickly; check what co_await returns and clean up (stop a motor, cancel
+ * the chassis motion) before co_return.
+ *
+ * Everything here runs on one task, nothing is locked. PROS-free, times are in milliseconds from
+ * whatever clock the caller passes to tick().
+ *
+ * Await into a local and test that, never co_await inside an if condition. GCC 12 can compile a
+ * coroutine with `if (!co_await a) co_return false;` into one whose body never runs, depending on
+ * the statements around it.
+ *
+ * <h3> Example Usage </h3>
+ * @code
+ * Action scoreWhileDriving() {
+ *     // drive and spin up the intake together, give up on both after 2 s
+ *     bool ok = co_await withTimeout(whenAll(auton::moveToPoint(24, 24, 1500), spinUp()), 2000);
+ *     co_return ok;
+ * }
+ * @endcode
+ */
+
+/* FRAMES */
+/**
+ * Fixed blocks for coroutine frames. Frames too large for a block, or beyond the pool, fall back
+ * to the heap and are counted
+ */
+class FramePool {
+    public:
+        static constexpr size_t blockSize = 512;
+        static constexpr size_t blockCount = 32;
+
+        void* allocate(size_t size) {
+            if (size <= blockSize) {
+                for (size_t i = 0; i < blockCount; i++) {
+                    if (used[i]) continue;
+                    used[i] = true;
+                    if (++inUse > peak) peak = inUse;
+                    return blocks[i];
+                }
+            }
+            heapFallbacks++;
+            return ::operator new(size);
+        }
+
+        void release(void* frame) {
+            unsigned char* bytes = static_cast<unsigned char*>(frame);
+            if (bytes >= blocks[0] && bytes < blocks[0] + sizeof(blocks)) {
+                used[(bytes - blocks[0]) / blockSize] = false;
+                inUse--;
+            } else {
+                ::operator delete(frame);
+            }
+        }
+
+        /**
+         * Forgets every frame, for when the task running the last set of actions was killed
+         * mid-run (a competition mode change) and its frames will never be resumed or freed
+         */
+        void reset() {
+            for (bool& block : used) block = false;
+            inUse = 0;
+        }
+
+        size_t inUse = 0;
+        size_t peak = 0;
+        size_t heapFallbacks = 0;
+    private:
+        alignas(std::max_align_t) unsigned char blocks[blockCount][blockSize];
+        bool used[blockCount] = {};
+};
+
+inline FramePool& framePool() {
+    static FramePool pool;
+    return pool;
+}
+
+/* ACTION */
+struct ActionJoin;
+
+class Action {
+    public:
+        struct promise_type {
+                std::coroutine_handle<> continuation = nullptr; // resumed when this one ends
+                promise_type* parent = nullptr; // the awaiting action, cancelling it cancels this
+                ActionJoin* join = nullptr; // set when run by whenAll/whenAny instead of awaited alone
+                bool cancelled = false;
+                bool done = false;
+                bool result = false;
+
+                bool isCancelled() const {
+                    for (const promise_type* p = this; p != nullptr; p = p->parent) {
+                        if (p->cancelled) return true;
+                    }
+                    return false;
+                }
+
+                Action get_return_object() {
+                    return Action(std::coroutine_handle<promise_type>::from_promise(*this));
+                }
+
+                std::suspend_always initial_suspend() noexcept { return {}; }
+
+                struct FinalAwaiter {
+                        bool await_ready() noexcept { return false; }
+
+                        std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> handle) noexcept;
+
+                        void await_resume() noexcept {}
+                };
+
+                FinalAwaiter final_suspend() noexcept { return {}; }
+
+                void return_value(bool ok) { result = ok; }
+
+                void unhandled_exception() { std::terminate(); }
+
+                static void* operator new(size_t size) { return framePool().allocate(size); }
+
+                static void operator delete(void* frame, size_t) { framePool().release(frame); }
+        };
+
+        Action(Action&& other) noexcept
+            : handle(std::exchange(other.handle, nullptr)) {}
+
+        Action& operator=(Action&& other) noexcept {
+            if (this != &other) {
+                if (handle) handle.destroy();
+                handle = std::exchange(other.handle, nullptr);
+            }
+            return *this;
+        }
+
+        Action(const Action&) = delete;
+        Action& operator=(const Action&) = delete;
+
+        ~Action() {
+            if (handle) handle.destroy();
+        }
+
+        /**
+         * Runs the action up to its first wait, for the top level action only; awaiting starts
+         * the others
+         */
+        void start() { handle.resume(); }
+
+        bool done() const { return handle.promise().done; }
+
+        bool result() const { return handle.promise().result; }
+
+        void cancel() { handle.promise().cancelled = true; }
+
+        bool await_ready() { return false; }
+
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> awaiting) {
+            handle.promise().continuation = awaiting;
+            handle.promise().parent = &awaiting.promise();
+            return handle;
+        }
+
+        bool await_resume() { return handle.promise().result; }
+    private:
+        explicit Action(std::coroutine_handle<promise_type> handle)
+            : handle(handle) {}
+
+        template <size_t count> friend class JoinAwaiter;
+
+        std::coroutine_handle<promise_type> handle;
+};
+
+/**
+ * Shared by the actions of one whenAll/whenAny: the last one to finish resumes the waiter
+ */
+struct ActionJoin {
+        Action::promise_type** children = nullptr;
+        size_t count = 0;
+        size_t remaining = 0;
+        size_t first = 0; // the first to finish
+        bool firstResult = false;
+        bool anyFinished = false;
+        bool cancelOthers = false;
+        std::coroutine_handle<> waiter = nullptr;
+
+        std::coroutine_handle<> childDone(Action::promise_type* child) {
+            if (!anyFinished) {
+                anyFinished = true;
+                firstResult = child->result;
+                for (size_t i = 0; i < count; i++) {
+                    if (children[i] == child) first = i;
+                    else if (cancelOthers) children[i]->cancelled = true;
+                }
+            }
+            if (--remaining == 0) return waiter;
+            return std::noop_coroutine();
+        }
+};
+
+inline std::coroutine_handle<> Action::promise_type::FinalAwaiter::await_suspend(
+    std::coroutine_handle<promise_type> handle) noexcept {
+    promise_type& promise = handle.promise();
+    promise.done = true;
+    if (promise.join != nullptr) return promise.join->childDone(&promise);
+    if (promise.continuation) return promise.continuation;
+    return std::noop_coroutine();
+}
+
+/* SCHEDULER */
+/**
+ * What a parked action waits for. Lives in the waiting coroutine's frame
+ */
+class ActionWaiter {
+    public:
+        /** true once the wait is over, with result set */
+        virtual bool poll(uint32_t now) = 0;
+
+        std::coroutine_handle<Action::promise_type> handle = nullptr;
+        bool result = false;
+    protected:
+        ~ActionWaiter() = default;
+};
+
+class CoroScheduler {
+    public:
+        static constexpr size_t maxWaiters = 32;
+
+        /**
+         * Wakes every action whose wait is over or that was cancelled, with now as the current time
+         */
+        void tick(uint32_t time) {
+            now = time;
+            ActionWaiter* ready[maxWaiters];
+            size_t readyCount = 0;
+            for (size_t i = 0; i < waiterCount;) {
+                ActionWaiter* waiter = waiters[i];
+                bool over = waiter->handle.promise().isCancelled();
+                if (over) waiter->result = false;
+                else over = waiter->poll(time);
+                if (over) {
+                    ready[readyCount++] = waiter;
+                    waiters[i] = waiters[--waiterCount];
+                } else {
+                    i++;
+                }
+            }
+            // resumed actions may park again, so only resume once the list is consistent
+            for (size_t i = 0; i < readyCount; i++) ready[i]->handle.resume();
+        }
+
+        /**
+         * False if too many actions are already waiting; the wait then fails at once
+         */
+        bool park(ActionWaiter* waiter) {
+            if (waiterCount == maxWaiters) {
+                overflows++;
+                return false;
+            }
+            waiters[waiterCount++] = waiter;
+            return true;
+        }
+
+        /**
+         * Drops every parked action, see FramePool::reset()
+         */
+        void reset(uint32_t time) {
+            waiterCount = 0;
+            now = time;
+        }
+
+        size_t waiting() const { return waiterCount; }
+
+        uint32_t now = 0; // the last tick's time, waits are measured from it
+        uint32_t overflows = 0;
+    private:
+        ActionWaiter* waiters[maxWaiters] = {};
+        size_t waiterCount = 0;
+};
+
+inline CoroScheduler& coroScheduler() {
+    static CoroScheduler scheduler;
+    return scheduler;
+}
+
+// millisecond times wrap, compare them by difference
+inline bool timeReached(uint32_t now, uint32_t time) { return static_cast<int32_t>(now - time) >= 0; }
+
+/**
+ * Base of the waits: doesn't suspend at all if the action is already cancelled
+ */
+class ParkedWait : public ActionWaiter {
+    public:
+        bool await_ready() { return false; }
+
+        bool await_suspend(std::coroutine_handle<Action::promise_type> awaiting) {
+            handle = awaiting;
+            if (awaiting.promise().isCancelled() || !coroScheduler().park(this)) {
+                result = false;
+                return false;
+            }
+            return true;
+        }
+
+        bool await_resume() { return result; }
+};
+
+class SleepFor : public ParkedWait {
+    public:
+        explicit SleepFor(uint32_t ms)
+            : until(coroScheduler().now + ms) {}
+
+        bool poll(uint32_t now) override {
+            result = true;
+            return timeReached(now, until);
+        }
+    private:
+        uint32_t until;
+};
+
+class WaitUntil : public ParkedWait {
+    public:
+        WaitUntil(bool (*condition)(), uint32_t timeoutMs)
+            : condition(condition),
+              until(coroScheduler().now + timeoutMs),
+              timeout(timeoutMs != 0) {}
+
+        bool poll(uint32_t now) override {
+            result = condition();
+            return result || (timeout && timeReached(now, until));
+        }
+    private:
+        bool (*condition)();
+        uint32_t until;
+        bool timeout;
+};
+
+/**
+ * Waits ms milliseconds. true unless cancelled
+ */
+inline SleepFor sleepFor(uint32_t ms) { return SleepFor(ms); }
+
+/**
+ * Waits for condition() to be true, checked every tick. false if cancelled or timeoutMs passed
+ * first (0 waits for as long as it takes)
+ */
+inline WaitUntil waitUntil(bool (*condition)(), uint32_t timeoutMs = 0) { return WaitUntil(condition, timeoutMs); }
+
+/* COMBINATORS */
+template <size_t count> class JoinAwaiter {
+    public:
+        JoinAwaiter(std::array<Action, count>&& actions, bool cancelOthers)
+            : actions(std::move(actions)) {
+            join.cancelOthers = cancelOthers;
+        }
+
+        bool await_ready() { return false; }
+
+        bool await_suspend(std::coroutine_handle<Action::promise_type> awaiting) {
+            join.children = children;
+            join.count = count;
+            join.waiter = awaiting;
+            // one extra so an action that finishes while the others are still starting can't
+            // resume the waiter from inside this call
+            join.remaining = count + 1;
+            for (size_t i = 0; i < count; i++) {
+                children[i] = &actions[i].handle.promise();
+                children[i]->parent = &awaiting.promise();
+                children[i]->join = &join;
+            }
+            for (Action& action : actions) action.handle.resume();
+            return --join.remaining != 0;
+        }
+    protected:
+        std::array<Action, count> actions;
+        Action::promise_type* children[count] = {};
+        ActionJoin join;
+};
+
+template <size_t count> class WhenAll : public JoinAwaiter<count> {
+    public:
+        using JoinAwaiter<count>::JoinAwaiter;
+
+        /** true if every action succeeded */
+        bool await_resume() {
+            for (Action::promise_type* child : this->children) {
+                if (!child->result) return false;
+            }
+            return true;
+        }
+};
+
+struct AnyResult {
+    size_t index; // the action that finished first
+    bool ok; // what it returned
+};
+
+template <size_t count> class WhenAny : public JoinAwaiter<count> {
+    public:
+        using JoinAwaiter<count>::JoinAwaiter;
+
+        AnyResult await_resume() { return {this->join.first, this->join.firstResult}; }
+};
+
+/**
+ * Runs the actions at once and resumes when all of them have finished
+ */
+template <typename... Actions> WhenAll<sizeof...(Actions)> whenAll(Actions&&... actions) {
+    return {std::array<Action, sizeof...(Actions)> {std::forward<Actions>(actions)...}, false};
+}
+
+/**
+ * Runs the actions at once; when the first finishes the rest are cancelled. Resumes once they have
+ * wound down, with which one finished first
+ */
+template <typename... Actions> WhenAny<sizeof...(Actions)> whenAny(Actions&&... actions) {
+    return {std::array<Action, sizeof...(Actions)> {std::forward<Actions>(actions)...}, true};
+}
+
+inline Action delayAction(uint32_t ms) { co_return co_await sleepFor(ms); }
+
+/**
+ * The action, cancelled if it is not done within ms. true only if it finished in time and succeeded
+ */
+inline Action withTimeout(Action action, uint32_t ms) {
+    AnyResult first = co_await whenAny(std::move(action), delayAction(ms));
+    co_return first.index == 0 && first.ok;
+}
+
+/* RUNNING */
+/**
+ * Runs the action makeAction() builds to its end on the calling task, with step() called until
+ * then to wait for the next tick and tick the scheduler. Returns what the action co_returned.
+ *
+ * The pool and scheduler are reset first, as a previous run cut off by a mode change leaves
+ * frames that will never be resumed or freed. The action is built only after that, so the reset
+ * never frees its frames
+ */
+template <typename Step> bool runAction(Action (*makeAction)(), uint32_t now, Step step) {
+    framePool().reset();
+    coroScheduler().reset(now);
+    Action action = makeAction();
+    action.start();
+    while (!action.done()) step();
+    return action.result();
+}
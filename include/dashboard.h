@@ -0,0 +1,34 @@
+#pragma once
+
+#include "main.h"
+
+/*
+ * Brain screen dashboard built on LVGL labels, a chart and the field map (field_map.h), fed from
+ * signalTable(). Below the chart a line shows each IMU's heading and orientation. The refresh is
+ * an lv_timer, so it runs on LVGL's task and never races a render.
+ *
+ * Each refresh reads the newest signal row and only touches a value when it moved by more than
+ * the tile's display threshold. Values are NumericLabels (numeric_label.h), which copy and
+ * invalidate just the digits that changed instead of running the font path for the whole label.
+ */
+
+struct DashboardStats {
+    uint32_t updateMicros = 0; // last refresh, reading signals and setting labels
+    uint32_t updateMicrosMax = 0;
+    uint32_t renderMicros = 0; // last LVGL refresh of the display, measured from its events
+    uint32_t renderMicrosMax = 0;
+    uint32_t invalidatedPixels = 0; // area redrawn by the last LVGL refresh
+    uint32_t labelsChanged = 0; // values redrawn by the last refresh
+    uint32_t refreshes = 0;
+};
+
+/**
+ * Loads the dashboard screen (replacing llemu's) on LVGL's next timer pass and refreshes it every
+ * periodMs milliseconds. Call after startSignalSampler()
+ */
+void startDashboard(uint32_t periodMs = 100);
+
+/**
+ * Refresh and render costs, also sampled as the dash_* signals
+ */
+DashboardStats getDashboardStats();
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "main.h"
+
+/*
+ * One task that runs the robot's short periodic jobs instead of a task (and a stack) each.
+ *
+ * Jobs are released at fixed times, start + n * period, so they never drift however long a run
+ * takes. When several are due together the shortest period runs first (rate-monotonic order).
+ * Jobs share the task, so a job must not wait for long: anything that can sit on a lock or a
+ * device (the radio) keeps a task of its own, and screen updates are lv_timers on LVGL's task.
+ *
+ * Every run after a job's first is a NoAllocScope (alloc_audit.h): jobs must not allocate.
+ *
+ * Per job it records run time against the job's budget, start jitter and deadline misses (the run
+ * ended after its next release). Releases that were already over when a late run ended are
+ * skipped, not run back to back.
+ *
+ * <h3> Example Usage </h3>
+ * @code
+ * static void sampleSomething() { ... }
+ * addPeriodicJob("something", 10, 500, sampleSomething);
+ * @endcode
+ */
+
+struct JobStats {
+    const char* name = nullptr;
+    uint32_t periodMs = 0;
+    uint32_t budgetUs = 0;
+    uint32_t runs = 0;
+    uint32_t lastUs = 0; // run time
+    uint32_t maxUs = 0;
+    uint32_t avgUs = 0;
+    uint32_t jitterUs = 0; // how far the last gap between starts was from the gap between their releases
+    uint32_t jitterUsMax = 0;
+    uint32_t overBudget = 0;
+    uint32_t deadlineMisses = 0;
+    uint32_t skipped = 0; // releases dropped because a run overran them
+};
+
+/**
+ * Adds a job, first released now, and starts the executor task on the first call. name must be a
+ * string literal (it is also the job's trace scope). False if the job table is full
+ */
+bool addPeriodicJob(const char* name, uint32_t periodMs, uint32_t budgetUs, void (*job)());
+
+/**
+ * Copies up to capacity jobs' stats into out. Returns how many were copied
+ */
+size_t getJobStats(JobStats* out, size_t capacity);
+
+/**
+ * Deadline misses across all jobs
+ */
+uint32_t getDeadlineMisses();
+
+/**
+ * Prints every job's stats to stdout, e.g. from disabled()
+ */
+void printExecutorReport();
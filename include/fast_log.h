@@ -0,0 +1,164 @@
+#pragma once
+
+#include "main.h"
+#define FMT_HEADER_ONLY
+#include "fmt/core.h"
+#include "lemlib/format.hpp"
+#include "log_ring.h"
+
+#ifndef LOG_MIN_LEVEL
+/** Lowest level compiled into the program (0 = INFO ... 4 = FATAL). Set from the Makefile */
+#define LOG_MIN_LEVEL 0
+#endif
+
+/**
+ * The lowest level that is compiled in. FastLogger's fixed-level calls (debug(), info(), ...) and
+ * FAST_LOG/SINK_LOG below it compile to nothing. lemlib is prebuilt, so its own logging and direct
+ * calls on its sinks are not affected
+ */
+constexpr lemlib::Level minLogLevel = static_cast<lemlib::Level>(LOG_MIN_LEVEL);
+
+/**
+ * Formats like the string it holds, so format strings taking a LogLiteral check at compile time
+ */
+template <> struct fmt::formatter<LogLiteral> : fmt::formatter<fmt::string_view> {
+        template <typename FormatContext> auto format(const LogLiteral& literal, FormatContext& ctx) const {
+            return fmt::formatter<fmt::string_view>::format(literal.text, ctx);
+        }
+};
+
+/**
+ * Logger for control loops.
+ *
+ * A call copies the format string pointer, a timestamp and the raw arguments into a lock-free
+ * queue and returns; a low priority task formats the records and queues them on boundedStdout(),
+ * which bounds the memory a burst can take and writes them out in batches. Arguments must
+ * be numbers, enums, string literals or LogLiteral (enforced at compile time). If either queue is
+ * full the record is dropped and counted (droppedCount(), boundedStdout().getStats()), the caller
+ * never waits.
+ *
+ * <h3> Example Usage </h3>
+ * @code
+ * fastLogger().setLowestLevel(lemlib::Level::INFO);
+ * fastLogger().info("odom x: {:.2f} y: {:.2f}", pose.x, pose.y);
+ * @endcode
+ */
+class FastLogger {
+    public:
+        FastLogger();
+        FastLogger(const FastLogger&) = delete;
+        FastLogger& operator=(const FastLogger&) = delete;
+
+        /**
+         * Messages below level are discarded before anything is copied.
+         * Uses lemlib's level order: INFO, DEBUG, WARN, ERROR, FATAL
+         */
+        void setLowestLevel(lemlib::Level level) { lowestLevel = level; }
+
+        lemlib::Level getLowestLevel() const { return lowestLevel; }
+
+        /**
+         * In structured mode the logger task skips formatting and writes each record as a binary
+         * frame (see log_frame.h): format string address, timestamp and raw arguments.
+         * Decode captures with tools/log_decode and the program's ELF files.
+         */
+        void setStructured(bool enabled) { structured = enabled; }
+
+        /**
+         * Whether a message at level would be recorded. Levels below LOG_MIN_LEVEL never are
+         */
+        bool isEnabled(lemlib::Level level) const { return level >= minLogLevel && level >= lowestLevel; }
+
+        template <typename... T> void log(lemlib::Level level, fmt::format_string<T...> format, T&&... args) {
+            if (!isEnabled(level)) return;
+            LogRecord record;
+            fmt::string_view view = format.get();
+            record.format = view.data();
+            record.formatLength = static_cast<uint16_t>(view.size());
+            record.level = level;
+            record.time = pros::millis();
+            captureLogArgs(record, args...);
+            ring.tryPush(record);
+        }
+
+        template <typename... T> void debug(fmt::format_string<T...> format, T&&... args) {
+            if constexpr (lemlib::Level::DEBUG >= minLogLevel) {
+                log(lemlib::Level::DEBUG, format, std::forward<T>(args)...);
+            }
+        }
+
+        template <typename... T> void info(fmt::format_string<T...> format, T&&... args) {
+            if constexpr (lemlib::Level::INFO >= minLogLevel) {
+                log(lemlib::Level::INFO, format, std::forward<T>(args)...);
+            }
+        }
+
+        template <typename... T> void warn(fmt::format_string<T...> format, T&&... args) {
+            if constexpr (lemlib::Level::WARN >= minLogLevel) {
+                log(lemlib::Level::WARN, format, std::forward<T>(args)...);
+            }
+        }
+
+        template <typename... T> void error(fmt::format_string<T...> format, T&&... args) {
+            if constexpr (lemlib::Level::ERROR >= minLogLevel) {
+                log(lemlib::Level::ERROR, format, std::forward<T>(args)...);
+            }
+        }
+
+        template <typename... T> void fatal(fmt::format_string<T...> format, T&&... args) {
+            if constexpr (lemlib::Level::FATAL >= minLogLevel) {
+                log(lemlib::Level::FATAL, format, std::forward<T>(args)...);
+            }
+        }
+
+        /**
+         * Records dropped because the queue was full
+         */
+        uint32_t droppedCount() const { return ring.droppedCount(); }
+    private:
+        /**
+         * Drains the queue, formats records and prints them in one write per wakeup
+         */
+        void taskLoop();
+
+        LogRing<256> ring;
+        lemlib::Level lowestLevel = lemlib::Level::WARN;
+        bool structured = false;
+        pros::Task task;
+};
+
+/**
+ * Get the deferred-formatting logger. The first call starts its task, so make it from initialize()
+ */
+FastLogger& fastLogger();
+
+/**
+ * Logs through fastLogger() only if the level is compiled in and enabled. Unlike calling
+ * fastLogger().debug(...) directly, the arguments are not even evaluated otherwise, so debug
+ * logging can stay in control loops at no cost to release builds (make LOG_MIN_LEVEL=2).
+ *
+ * <h3> Example Usage </h3>
+ * @code
+ * FAST_LOG(DEBUG, "lateral error: {:.3f}", computeError());
+ * @endcode
+ */
+#define FAST_LOG(level, ...)                                                                                           \
+    do {                                                                                                               \
+        if constexpr (lemlib::Level::level >= minLogLevel) {                                                           \
+            if (fastLogger().isEnabled(lemlib::Level::level)) fastLogger().log(lemlib::Level::level, __VA_ARGS__);     \
+        }                                                                                                              \
+    } while (0)
+
+/**
+ * Logs to a lemlib sink only if the level is compiled in. Below LOG_MIN_LEVEL the arguments are
+ * not evaluated; above it the sink's own level check applies, as with sink->log(...).
+ *
+ * <h3> Example Usage </h3>
+ * @code
+ * SINK_LOG(lemlib::infoSink(), DEBUG, "pose: {}", chassis.getPose());
+ * @endcode
+ */
+#define SINK_LOG(sink, level, ...)                                                                                     \
+    do {                                                                                                               \
+        if constexpr (lemlib::Level::level >= minLogLevel) (sink)->log(lemlib::Level::level, __VA_ARGS__);            \
+    } while (0)
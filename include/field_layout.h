@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include "path_planner.h"
+
+/*
+ * The field the planner (path_planner.h) routes across, shared by the robot and tools/route_plan.
+ *
+ * Measured from the game manual drawings, not the real field: rectangles around each element's
+ * footprint, in field inches from the bottom left corner. The park zone barriers and loose blocks
+ * are driven over and are left out. Check them against the field before trusting a tight route.
+ */
+
+constexpr FieldRect fieldObstacles[] = {
+    {22, 48, 26, 96}, // long goals, left and right
+    {118, 48, 122, 96},
+    {64, 64, 80, 80}, // centre goals, the crossing and its legs
+    {0, 22, 4, 26}, // match loaders, against the side walls at the long goals' ends
+    {0, 118, 4, 122},
+    {140, 22, 144, 26},
+    {140, 118, 144, 122},
+};
+
+constexpr size_t fieldObstacleCount = sizeof(fieldObstacles) / sizeof(fieldObstacles[0]);
+
+// odometry's (0, 0) on the field, the same as FieldMapConfig's default (field_map.h)
+constexpr float odomOriginX = 72;
+constexpr float odomOriginY = 24;
+
+// half the drivetrain's diagonal, the circle the robot turns in
+constexpr float robotRadiusInches = 9;
+
+/**
+ * A moveToPoint timeout for a leg of the given length: half as long again as it takes at a
+ * cautious 40 in/s, plus time to settle
+ */
+constexpr int legTimeoutMs(float inches) { return static_cast<int>(inches / 40 * 1000 * 1.5f) + 300; }
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "main.h"
+#include "liblvgl/lvgl.h"
+
+/*
+ * LVGL field view: the field, the auton routes from auton.cpp and the robot's live trail.
+ *
+ * The field and routes are drawn once into a cached draw buffer. Each update only draws the
+ * trail segment since the last pose straight into the canvas buffer and invalidates that
+ * segment's bounds; the robot marker is a small object of its own, so moving it redraws its old
+ * and new position only.
+ */
+
+struct FieldMapConfig {
+    int32_t size = 240; // pixels, the map is square
+    // where odometry's (0, 0) is on the field, inches from the bottom left corner. Adjust for the
+    // starting tile
+    float originX = 72;
+    float originY = 24;
+    float jumpDistance = 12; // inches between two updates that counts as a setPose, not driving
+};
+
+/**
+ * Creates the map at (x, y) in parent. Call from LVGL's task (an lv_timer callback)
+ */
+lv_obj_t* createFieldMap(lv_obj_t* parent, int32_t x, int32_t y, const FieldMapConfig& config = {});
+
+/**
+ * Moves the robot to a pose (inches, degrees, as chassis.getPose() reports) and extends the
+ * trail. Call from LVGL's task (an lv_timer callback)
+ */
+void updateFieldMap(float x, float y, float thetaDeg);
+
+/**
+ * Clears the trail back to the cached field and routes on the next update. Safe from any task
+ */
+void clearFieldMapTrail();
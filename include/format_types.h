@@ -0,0 +1,69 @@
+#pragma once
+
+#include <string_view>
+#include "lemlib/format.hpp"
+#include "state_sync.h"
+#include "object_tracker.h"
+
+/*
+ * fmt formatters for the project's motion-state types, in the style of lemlib/format.hpp:
+ * ".N" sets the precision of every float, e.g. "{:.1}".
+ */
+
+/**
+ * Formats into a caller-provided buffer, truncating if it is too small. The result is null
+ * terminated, so it can go straight to printf-style APIs like pros::lcd::print("%s")
+ */
+template <size_t size, typename... T>
+std::string_view formatInto(char (&buffer)[size], fmt::format_string<T...> format, T&&... args) {
+    auto result = fmt::format_to_n(buffer, size - 1, format, std::forward<T>(args)...);
+    size_t length = result.size < size - 1 ? result.size : size - 1;
+    buffer[length] = '\0';
+    return std::string_view(buffer, length);
+}
+
+/**
+ * "(x, y, theta) mech 0x05 path [(x, y), ...]"
+ */
+template <> struct fmt::formatter<RobotSyncState> {
+        int precision = -1;
+
+        constexpr auto parse(format_parse_context& ctx) { return lemlib::parseFormatPrecision(ctx, precision); }
+
+        template <typename FormatContext> auto format(const RobotSyncState& state, FormatContext& ctx) const {
+            auto out = lemlib::formatText(ctx.out(), "(");
+            out = lemlib::formatFloat(out, state.x, precision);
+            out = lemlib::formatText(out, ", ");
+            out = lemlib::formatFloat(out, state.y, precision);
+            out = lemlib::formatText(out, ", ");
+            out = lemlib::formatFloat(out, state.theta, precision);
+            out = fmt::format_to(out, ") mech {:#04x} path [", state.mechanism);
+            for (uint8_t i = 0; i < state.pathCount && i < syncMaxPathPoints; i++) {
+                out = lemlib::formatText(out, i == 0 ? "(" : ", (");
+                out = lemlib::formatFloat(out, state.path[i].x, precision);
+                out = lemlib::formatText(out, ", ");
+                out = lemlib::formatFloat(out, state.path[i].y, precision);
+                out = lemlib::formatText(out, ")");
+            }
+            return lemlib::formatText(out, "]");
+        }
+};
+
+/**
+ * "#12 class 1 at (x, y) in, 5 hits" plus " (tentative)" until the track is confirmed
+ */
+template <> struct fmt::formatter<Track> {
+        int precision = -1;
+
+        constexpr auto parse(format_parse_context& ctx) { return lemlib::parseFormatPrecision(ctx, precision); }
+
+        template <typename FormatContext> auto format(const Track& track, FormatContext& ctx) const {
+            auto out = fmt::format_to(ctx.out(), "#{} class {} at (", track.id, track.classId);
+            out = lemlib::formatFloat(out, track.fieldX, precision);
+            out = lemlib::formatText(out, ", ");
+            out = lemlib::formatFloat(out, track.fieldY, precision);
+            out = fmt::format_to(out, ") in, {} hits", track.hits);
+            if (!track.confirmed()) out = lemlib::formatText(out, " (tentative)");
+            return out;
+        }
+};
@@ -0,0 +1,18 @@
+#pragma once
+
+/*
+ * HOT_PATH marks a function called from a control loop every cycle. It goes in .text.hot_path,
+ * which the linker script places together at the start of .text. In a `make HOT_OPT=1` build
+ * it is also compiled at -O$(HOT_OPT_LEVEL), even if its file is built at -Os.
+ *
+ * Use it on functions defined in .cpp files: inline and template functions are emitted in every
+ * file that uses them and cannot share one named section.
+ */
+#define HOT_PATH_STRING2(x) #x
+#define HOT_PATH_STRING(x) HOT_PATH_STRING2(x)
+
+#ifdef HOT_OPT_LEVEL
+#define HOT_PATH __attribute__((hot, section(".text.hot_path"), optimize("O" HOT_PATH_STRING(HOT_OPT_LEVEL))))
+#else
+#define HOT_PATH __attribute__((section(".text.hot_path")))
+#endif
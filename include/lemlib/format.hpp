@@ -0,0 +1,126 @@
+#pragma once
+
+#include <algorithm>
+#include <string_view>
+
+#define FMT_HEADER_ONLY
+#include "fmt/format.h"
+
+#include "lemlib/pose.hpp"
+#include "lemlib/logger/message.hpp"
+
+namespace lemlib {
+/**
+ * @brief Name of a level, without allocating
+ *
+ * @param level
+ * @return std::string_view "INFO", "DEBUG", ...
+ */
+constexpr std::string_view levelName(Level level) {
+    switch (level) {
+        case Level::INFO: return "INFO";
+        case Level::DEBUG: return "DEBUG";
+        case Level::WARN: return "WARN";
+        case Level::ERROR: return "ERROR";
+        case Level::FATAL: return "FATAL";
+    }
+    return "UNKNOWN";
+}
+
+/**
+ * @brief Parses an optional ".N" precision followed by an optional presentation character
+ *
+ * @return the iterator at the closing brace
+ */
+template <typename ParseContext>
+constexpr auto parseFormatPrecision(ParseContext& ctx, int& precision, char presentation = 0, bool* present = nullptr) {
+    auto it = ctx.begin();
+    if (it != ctx.end() && *it == '.') {
+        precision = 0;
+        for (++it; it != ctx.end() && *it >= '0' && *it <= '9'; ++it) precision = precision * 10 + (*it - '0');
+    }
+    if (present != nullptr && it != ctx.end() && *it == presentation) {
+        *present = true;
+        ++it;
+    }
+    if (it != ctx.end() && *it != '}') throw fmt::format_error("invalid format specifier");
+    return it;
+}
+
+/**
+ * @brief Copies text to a formatter's output as is
+ */
+template <typename OutputIt> OutputIt formatText(OutputIt out, std::string_view text) {
+    return std::copy(text.begin(), text.end(), out);
+}
+
+/**
+ * @brief Writes a float with an optional fixed precision (-1 keeps fmt's shortest form)
+ */
+template <typename OutputIt> OutputIt formatFloat(OutputIt out, float value, int precision) {
+    if (precision < 0) return fmt::format_to(out, "{}", value);
+    return fmt::format_to(out, "{:.{}f}", value, precision);
+}
+} // namespace lemlib
+
+/*
+ * These formatters write straight into fmt's output (a fmt::memory_buffer, a stack buffer through
+ * fmt::format_to_n, ...), where lemlib's format_as overloads (lemlib/pose.hpp,
+ * lemlib/logger/message.hpp) would build a std::string first.
+ * As explicit specializations they take priority over fmt's format_as fallback.
+ */
+
+/**
+ * Pose. "{}" matches format_as, "lemlib::Pose { x: 1, y: 2, theta: 90 }".
+ * ".N" fixes the precision of every field, "c" prints just "x, y, theta", e.g. "{:.2c}"
+ */
+template <> struct fmt::formatter<lemlib::Pose> {
+        int precision = -1;
+        bool compact = false;
+
+        constexpr auto parse(format_parse_context& ctx) { return lemlib::parseFormatPrecision(ctx, precision, 'c', &compact); }
+
+        template <typename FormatContext> auto format(const lemlib::Pose& pose, FormatContext& ctx) const {
+            auto out = ctx.out();
+            if (!compact) out = lemlib::formatText(out, "lemlib::Pose { x: ");
+            out = lemlib::formatFloat(out, pose.x, precision);
+            out = lemlib::formatText(out, compact ? ", " : ", y: ");
+            out = lemlib::formatFloat(out, pose.y, precision);
+            out = lemlib::formatText(out, compact ? ", " : ", theta: ");
+            out = lemlib::formatFloat(out, pose.theta, precision);
+            if (!compact) out = lemlib::formatText(out, " }");
+            return out;
+        }
+};
+
+/**
+ * Level, accepts the same width and alignment options as a string ("{:<5}")
+ */
+template <> struct fmt::formatter<lemlib::Level> : fmt::formatter<std::string_view> {
+        template <typename FormatContext> auto format(lemlib::Level level, FormatContext& ctx) const {
+            return fmt::formatter<std::string_view>::format(lemlib::levelName(level), ctx);
+        }
+};
+
+/**
+ * Message. "{}" writes the text alone, "{:f}" writes "[time] LEVEL: text"
+ */
+template <> struct fmt::formatter<lemlib::Message> {
+        bool full = false;
+
+        constexpr auto parse(format_parse_context& ctx) {
+            auto it = ctx.begin();
+            if (it != ctx.end() && *it == 'f') {
+                full = true;
+                ++it;
+            }
+            if (it != ctx.end() && *it != '}') throw fmt::format_error("invalid format specifier");
+            return it;
+        }
+
+        template <typename FormatContext> auto format(const lemlib::Message& message, FormatContext& ctx) const {
+            if (!full) return fmt::format_to(ctx.out(), "{}", std::string_view(message.message));
+            return fmt::format_to(ctx.out(), "[{}] {}: {}", message.time, lemlib::levelName(message.level),
+                                  std::string_view(message.message));
+        }
+};
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "main.h"
+#include "pros/link.hpp"
+#include "state_sync.h"
+
+/* MECHANISM BITS */
+constexpr uint8_t syncIntakeRunning = 1 << 0;
+constexpr uint8_t syncTongueExtended = 1 << 1;
+constexpr uint8_t syncInMotion = 1 << 2;
+
+/**
+ * The VEXlink id both robots open the link with. Radios only pair with the same id; which end
+ * transmits is startStateSync()'s transmitter flag
+ */
+constexpr const char* stateSyncLinkId = "skillsusa_sync";
+
+/**
+ * SyncTransport over a VEXlink radio
+ */
+class LinkTransport : public SyncTransport {
+    public:
+        LinkTransport(uint8_t port, const char* linkId, bool transmitter);
+        bool send(const uint8_t* packet) override;
+        bool receive(uint8_t* out) override;
+    private:
+        pros::Link link;
+};
+
+/**
+ * Starts sharing our pose, intended path and mechanism state with the alliance partner,
+ * and receiving theirs, every periodMs milliseconds. One robot must be the transmitter.
+ *
+ * The receiving radio only gets ~520 bytes/s, so 50 ms (16 byte packets plus link framing) is
+ * about as fast as both directions can go.
+ */
+void startStateSync(uint8_t port, bool transmitter, uint32_t periodMs = 50);
+
+/**
+ * Sets the path the partner sees as our intent, usually the next few auton targets
+ */
+void setSyncPath(const SyncPoint* points, uint8_t count);
+
+/**
+ * Copies the latest partner state into state. Returns false if nothing has been received yet
+ */
+bool getPartnerState(RobotSyncState& state);
+
+/**
+ * Link statistics, sent (our packets) and received (partner packets)
+ */
+SyncStats getSyncTxStats();
+SyncStats getSyncRxStats();
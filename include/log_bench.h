@@ -0,0 +1,12 @@
+#pragma once
+
+#include "main.h"
+
+/**
+ * Times the logging paths (compiled out, runtime filtered, deferred, lemlib sink) over
+ * iterations calls each and prints the cost per call to stdout.
+ *
+ * `make LOG_BENCH=1` runs it once at the end of initialize(), with the robot idle. Build it
+ * with LOG_MIN_LEVEL=0 and 2 to compare the numbers; `make log-size` compares the code size.
+ */
+void runLogBenchmark(uint32_t iterations = 10000);
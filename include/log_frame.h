@@ -0,0 +1,99 @@
+#pragma once
+
+#include "log_ring.h"
+#include "telemetry_protocol.h"
+
+/*
+ * Binary form of a LogRecord, used by FastLogger's structured mode and decoded on Linux by
+ * tools/log_decode.cpp.
+ *
+ * raw frame:  [0xF0][level u8][argc u8][format address u32][time_ms u32][types, argc bytes][values][crc16]
+ *
+ * The format string is identified by its address in the program image: format strings passed to
+ * FastLogger are literals, so the address is fixed at link time and the decoder reads the text
+ * back out of the ELF. String arguments (also literals) are sent the same way. Values take 1, 4 or
+ * 8 bytes depending on their type. Frames are COBS encoded and 0x00 delimited like telemetry
+ * frames, so both can share stdout; the 0xF0 marker is not a telemetry channel id.
+ */
+
+constexpr uint8_t logFrameMarker = 0xF0;
+constexpr size_t logFrameHeaderSize = 11;
+constexpr size_t logMaxRawSize = logFrameHeaderSize + logMaxArgs + logMaxArgs * 8 + 2;
+constexpr size_t logMaxFrameSize = logMaxRawSize + logMaxRawSize / 254 + 3;
+
+inline constexpr size_t logArgSize(LogArgType type) {
+    switch (type) {
+        case LogArgType::BOOL:
+        case LogArgType::CHAR: return 1;
+        case LogArgType::I64:
+        case LogArgType::U64:
+        case LogArgType::F64: return 8;
+        case LogArgType::NONE: return 0;
+        default: return 4; // 32 bit values and string addresses
+    }
+}
+
+/**
+ * Encodes record into out (logMaxFrameSize bytes), including the delimiters. Returns the length
+ */
+inline size_t encodeLogFrame(const LogRecord& record, uint8_t* out) {
+    uint8_t raw[logMaxRawSize];
+    uint32_t address = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(record.format));
+    raw[0] = logFrameMarker;
+    raw[1] = static_cast<uint8_t>(record.level);
+    raw[2] = record.argCount;
+    std::memcpy(raw + 3, &address, 4);
+    std::memcpy(raw + 7, &record.time, 4);
+    size_t length = logFrameHeaderSize;
+    for (uint8_t i = 0; i < record.argCount; i++) raw[length++] = static_cast<uint8_t>(record.types[i]);
+    for (uint8_t i = 0; i < record.argCount; i++) {
+        // little endian, so the low bytes of the 64 bit slot are the value
+        size_t size = logArgSize(record.types[i]);
+        std::memcpy(raw + length, &record.values[i], size);
+        length += size;
+    }
+    uint16_t crc = crc16Ccitt(raw, length);
+    std::memcpy(raw + length, &crc, 2);
+    return encodeWireFrame(raw, length + 2, out);
+}
+
+struct DecodedLog {
+    lemlib::Level level;
+    uint32_t formatAddress;
+    uint32_t time;
+    uint8_t argCount;
+    LogArgType types[logMaxArgs];
+    uint64_t values[logMaxArgs]; // sign extended for I32, string addresses for STR
+};
+
+/**
+ * Decodes a frame without its delimiter. Returns false if it is not a valid log frame
+ */
+inline bool decodeLogFrame(const uint8_t* frame, size_t length, DecodedLog& log) {
+    uint8_t raw[logMaxRawSize];
+    size_t rawLength = cobsDecode(frame, length, raw, sizeof(raw));
+    if (rawLength < logFrameHeaderSize + 2 || raw[0] != logFrameMarker || raw[2] > logMaxArgs) return false;
+    uint16_t crc;
+    std::memcpy(&crc, raw + rawLength - 2, 2);
+    if (crc != crc16Ccitt(raw, rawLength - 2)) return false;
+    log.level = static_cast<lemlib::Level>(raw[1]);
+    log.argCount = raw[2];
+    std::memcpy(&log.formatAddress, raw + 3, 4);
+    std::memcpy(&log.time, raw + 7, 4);
+    size_t offset = logFrameHeaderSize;
+    for (uint8_t i = 0; i < log.argCount; i++) {
+        log.types[i] = static_cast<LogArgType>(raw[offset++]);
+        if (log.types[i] > LogArgType::STR) return false;
+    }
+    for (uint8_t i = 0; i < log.argCount; i++) {
+        size_t size = logArgSize(log.types[i]);
+        if (offset + size > rawLength - 2) return false;
+        log.values[i] = 0;
+        std::memcpy(&log.values[i], raw + offset, size);
+        if (log.types[i] == LogArgType::I32) {
+            log.values[i] = static_cast<uint64_t>(static_cast<int64_t>(static_cast<int32_t>(log.values[i])));
+        }
+        offset += size;
+    }
+    return offset == rawLength - 2;
+}
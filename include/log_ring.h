@@ -0,0 +1,155 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include "lemlib/logger/message.hpp"
+
+/*
+ * Raw log records and the lock-free queue they travel through. A call site copies its format
+ * string pointer and arguments into a fixed-size LogRecord; formatting happens later, on
+ * whichever task drains the queue. PROS-free so host tools can share the record layout.
+ */
+
+/* RECORDS */
+enum class LogArgType : uint8_t { NONE, BOOL, CHAR, I32, U32, I64, U64, F32, F64, STR };
+
+constexpr size_t logMaxArgs = 6;
+
+/**
+ * A string argument that outlives any deferred record. String literals convert implicitly; a
+ * pointer has to be vouched for with fromStatic(). Plain char pointers are rejected at compile
+ * time, since a stack buffer or c_str() would be gone by the time the logger task formats it.
+ */
+struct LogLiteral {
+    template <size_t N> constexpr LogLiteral(const char (&literal)[N])
+        : text(literal) {}
+
+    /**
+     * text must never change or be freed, like a task name copied into a static table. Structured
+     * mode (log_frame.h) only decodes literals, anything else shows as an unknown string
+     */
+    static constexpr LogLiteral fromStatic(const char* text) { return LogLiteral(text, 0); }
+
+    const char* text;
+    private:
+        constexpr LogLiteral(const char* text, int)
+            : text(text) {}
+};
+
+struct LogRecord {
+    const char* format; // must have static storage duration (string literal)
+    uint16_t formatLength;
+    lemlib::Level level;
+    uint8_t argCount;
+    uint32_t time; // ms
+    LogArgType types[logMaxArgs];
+    uint64_t values[logMaxArgs]; // raw bits, interpreted by types[i]
+};
+
+namespace log_detail {
+template <typename T> constexpr LogArgType argType() {
+    using U = std::remove_cv_t<std::remove_reference_t<T>>;
+    if constexpr (std::is_same_v<U, bool>) return LogArgType::BOOL;
+    else if constexpr (std::is_same_v<U, char>) return LogArgType::CHAR;
+    else if constexpr (std::is_same_v<U, float>) return LogArgType::F32;
+    else if constexpr (std::is_same_v<U, double>) return LogArgType::F64;
+    else if constexpr (std::is_enum_v<U>) return sizeof(U) > 4 ? LogArgType::I64 : LogArgType::I32;
+    else if constexpr (std::is_integral_v<U> && std::is_signed_v<U>) return sizeof(U) > 4 ? LogArgType::I64 : LogArgType::I32;
+    else if constexpr (std::is_integral_v<U>) return sizeof(U) > 4 ? LogArgType::U64 : LogArgType::U32;
+    // string literals (const char arrays, tested before remove_cv strips the elements' const) and
+    // LogLiteral only: a char* may be gone by the time the record is formatted
+    else if constexpr (std::is_array_v<std::remove_reference_t<T>> &&
+                       std::is_same_v<std::remove_extent_t<std::remove_reference_t<T>>, const char>)
+        return LogArgType::STR;
+    else if constexpr (std::is_same_v<U, LogLiteral>) return LogArgType::STR;
+    else return LogArgType::NONE;
+}
+
+template <typename T> inline uint64_t argBits(const T& value) {
+    using U = std::remove_cv_t<std::remove_reference_t<T>>;
+    uint64_t bits = 0;
+    if constexpr (std::is_same_v<U, float> || std::is_same_v<U, double>) {
+        std::memcpy(&bits, &value, sizeof(U));
+    } else if constexpr (std::is_enum_v<U> || std::is_integral_v<U>) {
+        bits = static_cast<uint64_t>(static_cast<int64_t>(value));
+    } else if constexpr (std::is_same_v<U, LogLiteral>) {
+        bits = reinterpret_cast<uintptr_t>(value.text);
+    } else {
+        bits = reinterpret_cast<uintptr_t>(static_cast<const char*>(value));
+    }
+    return bits;
+}
+} // namespace log_detail
+
+/**
+ * Fills record's argument slots from args. Only arithmetic types, enums and string literals
+ * can be deferred: anything else would have to be formatted (and allocated) at the call site.
+ */
+template <typename... T> inline void captureLogArgs(LogRecord& record, T&&... args) {
+    static_assert(sizeof...(T) <= logMaxArgs, "too many arguments for a deferred log record");
+    static_assert(((log_detail::argType<T>() != LogArgType::NONE) && ...),
+                  "deferred logs only take numbers, enums, string literals and LogLiteral");
+    record.argCount = sizeof...(T);
+    size_t i = 0;
+    ((record.types[i] = log_detail::argType<T>(), record.values[i] = log_detail::argBits(args), i++), ...);
+}
+
+/* QUEUE */
+/**
+ * Bounded multi-producer single-consumer queue (Vyukov's sequence-per-slot design).
+ * Producers never block or take a lock: tryPush fails when the queue is full.
+ */
+template <size_t capacity> class LogRing {
+        static_assert((capacity & (capacity - 1)) == 0, "capacity must be a power of two");
+    public:
+        LogRing() {
+            for (size_t i = 0; i < capacity; i++) slots[i].sequence.store(i, std::memory_order_relaxed);
+        }
+
+        bool tryPush(const LogRecord& record) {
+            size_t position = tail.load(std::memory_order_relaxed);
+            while (true) {
+                Slot& slot = slots[position & (capacity - 1)];
+                size_t sequence = slot.sequence.load(std::memory_order_acquire);
+                intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+                if (difference == 0) {
+                    if (tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                        slot.record = record;
+                        slot.sequence.store(position + 1, std::memory_order_release);
+                        return true;
+                    }
+                } else if (difference < 0) {
+                    dropped.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                } else {
+                    position = tail.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        bool tryPop(LogRecord& record) {
+            Slot& slot = slots[head & (capacity - 1)];
+            size_t sequence = slot.sequence.load(std::memory_order_acquire);
+            if (static_cast<intptr_t>(sequence) - static_cast<intptr_t>(head + 1) < 0) return false;
+            record = slot.record;
+            slot.sequence.store(head + capacity, std::memory_order_release);
+            head++;
+            return true;
+        }
+
+        /** records rejected because the queue was full */
+        uint32_t droppedCount() const { return dropped.load(std::memory_order_relaxed); }
+    private:
+        struct Slot {
+                std::atomic<size_t> sequence;
+                LogRecord record;
+        };
+
+        Slot slots[capacity];
+        std::atomic<size_t> tail {0};
+        size_t head = 0; // only touched by the consumer
+        std::atomic<uint32_t> dropped {0};
+};
@@ -0,0 +1,15 @@
+#pragma once
+
+#include "main.h"
+
+/**
+ * Renders representative brain screen scenes (full repaint, text tiles, numeric labels, charts,
+ * canvas) into off-screen 480x240 displays, one per color format, and prints per scene frame and
+ * render time, invalidated areas and render cost per pixel to stdout.
+ *
+ * The displays have no refresh timer and a flush that returns at once, so the numbers are LVGL's
+ * software renderer alone. The scenes run on LVGL's task, one per timer pass, and the call returns
+ * when the last one is done. `make LVGL_BENCH=1` runs it once at the end of initialize(), with the
+ * robot idle; the real screen keeps refreshing between scenes but is not measured.
+ */
+void runLvglBenchmark(uint32_t frames = 50);
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "main.h"
+
+/*
+ * Watches LVGL's built-in heap (LV_MEM_SIZE in lv_conf.h) with lv_mem_monitor(). The numbers are
+ * sampled as the lvgl_heap_* signals, so they reach the card and the serial stream with the rest
+ * of the telemetry.
+ */
+
+struct LvglHeapStats {
+    uint32_t totalBytes = 0;
+    uint32_t usedBytes = 0;
+    uint32_t peakUsedBytes = 0; // since the program started
+    uint32_t largestFreeBlock = 0; // the biggest allocation that can still succeed
+    uint32_t usedBlocks = 0;
+    uint8_t fragmentationPct = 0; // 100 - largest free block * 100 / free bytes
+    float allocationRate = 0; // bytes per second, net change in used bytes since the last check
+    uint32_t lowHeadroomAlerts = 0;
+};
+
+/**
+ * Checks the heap every periodMs milliseconds from an lv_timer on LVGL's task. When the largest
+ * free block drops below minHeadroomBytes it logs a warning through fastLogger(), once per dip
+ */
+void startLvglHeapMonitor(uint32_t periodMs = 500, uint32_t minHeadroomBytes = 256 * 1024);
+
+LvglHeapStats getLvglHeapStats();
+
+/**
+ * A pool size for LV_MEM_SIZE from the measured peak plus 25% margin, rounded up to 64 KB
+ */
+uint32_t recommendedLvglPoolSize();
+
+/**
+ * Prints the peak use and the recommended LV_MEM_SIZE to stdout, e.g. at the end of a match
+ */
+void printLvglHeapReport();
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "main.h"
+#include "liblvgl/lvgl.h"
+
+/*
+ * Number readouts that skip LVGL's font path.
+ *
+ * A GlyphAtlas renders the characters numbers use ("0-9", '-', '+', '.', ' ') once, each into a
+ * fixed-width cell on the label's background color. A NumericLabel is a row of those cells in a
+ * canvas: setting a new value copies only the cells whose character changed and invalidates just
+ * those cells, so the screen redraw is a plain copy of a few small rectangles. Text with any
+ * other character goes to a normal lv_label instead.
+ */
+
+class GlyphAtlas {
+    public:
+        /**
+         * Renders the atlas. Call from LVGL's task (an lv_timer callback)
+         */
+        GlyphAtlas(const lv_font_t* font, lv_color_t text, lv_color_t background);
+        GlyphAtlas(const GlyphAtlas&) = delete;
+        GlyphAtlas& operator=(const GlyphAtlas&) = delete;
+        ~GlyphAtlas();
+
+        /**
+         * Whether c has a cell, i.e. whether it can be shown without the font path
+         */
+        bool has(char c) const;
+
+        /**
+         * Where c's cell is in buffer(). c must be in the atlas
+         */
+        lv_area_t cell(char c) const;
+
+        int32_t cellWidth() const { return width; }
+        int32_t cellHeight() const { return height; }
+        const lv_font_t* getFont() const { return font; }
+        lv_color_t getTextColor() const { return textColor; }
+        lv_color_t getBackground() const { return background; }
+        const lv_draw_buf_t* buffer() const { return atlas; }
+    private:
+        const lv_font_t* font;
+        lv_color_t textColor;
+        lv_color_t background;
+        int32_t width = 0;
+        int32_t height = 0;
+        lv_draw_buf_t* atlas = nullptr;
+};
+
+class NumericLabel {
+    public:
+        /**
+         * A right aligned field of chars cells. Call from LVGL's task (an lv_timer callback); the
+         * atlas must outlive the label
+         */
+        NumericLabel(lv_obj_t* parent, const GlyphAtlas& atlas, size_t chars);
+        NumericLabel(const NumericLabel&) = delete;
+        NumericLabel& operator=(const NumericLabel&) = delete;
+        ~NumericLabel();
+
+        /**
+         * The container, for positioning
+         */
+        lv_obj_t* obj() const { return container; }
+
+        /**
+         * Shows text, through the atlas if it can. Call from LVGL's task (an lv_timer callback).
+         * Returns the number of cells redrawn (a fallback label counts as all of them)
+         */
+        size_t setText(const char* text);
+
+        /**
+         * setText() with the value formatted to decimals places
+         */
+        size_t setValue(float value, int decimals);
+    private:
+        void showFallback(bool fallback);
+
+        const GlyphAtlas& atlas;
+        size_t chars;
+        lv_obj_t* container = nullptr;
+        lv_obj_t* canvas = nullptr;
+        lv_obj_t* fallbackLabel = nullptr;
+        lv_draw_buf_t* cells = nullptr;
+        char shown[24] = {}; // the character in each cell, 0 if never drawn
+        bool usingFallback = false;
+};
@@ -0,0 +1,206 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+/*
+ * Frame-to-frame tracking of camera detections. Pure C++ with fixed-size storage so it can
+ * run inside a sensor task without touching the heap, and be replayed on Linux
+ * (tools/tracker_replay.cpp).
+ *
+ * Each frame: tracks are moved forward with a constant-velocity model, detections are matched
+ * to them greedily by IoU (falling back to centre distance for small or fast objects), unmatched
+ * detections start tentative tracks, and tracks that keep missing are dropped. The work per frame
+ * is bounded by maxTracks * maxDetections pair checks.
+ */
+
+/* INPUT */
+struct Detection {
+    float x; // left edge, pixels
+    float y; // top edge, pixels
+    float width;
+    float height;
+    uint8_t classId;
+};
+
+/**
+ * Pinhole model of a camera mounted on the robot, used to put tracks on the field
+ */
+struct CameraModel {
+    float imageWidth = 320; // pixels
+    float horizontalFov = 74; // degrees
+    float focalLength = 0; // pixels, derived from the fov when 0
+    float offsetX = 0; // camera position relative to the tracking centre, inches (right)
+    float offsetY = 0; // inches (forward)
+    float objectHeight = 3.5; // real height of the tracked objects, inches
+
+    float focal() const {
+        if (focalLength > 0) return focalLength;
+        return imageWidth / 2 / std::tan(horizontalFov * static_cast<float>(M_PI) / 360);
+    }
+};
+
+/* OUTPUT */
+struct Track {
+    uint16_t id;
+    uint8_t classId;
+    uint8_t hits; // frames matched, saturates at 255
+    uint8_t misses; // consecutive frames without a match
+    float cx; // box centre, pixels
+    float cy;
+    float vx; // pixels per ms
+    float vy;
+    float width;
+    float height;
+    float fieldX; // last projected field position, inches
+    float fieldY;
+    uint32_t lastSeen; // ms
+
+    bool confirmed() const { return hits >= 3; }
+};
+
+struct TrackerSettings {
+    float minIou = 0.2f; // weakest overlap accepted as the same object
+    float maxCentreDistance = 40; // pixels, used when boxes do not overlap enough
+    uint8_t maxMisses = 5; // frames a track survives without detections
+    float velocitySmoothing = 0.5f; // 1 = use only the latest frame's velocity
+};
+
+/* TRACKER */
+template <size_t maxTracks = 16, size_t maxDetections = 24> class ObjectTracker {
+    public:
+        explicit ObjectTracker(TrackerSettings settings = {}, CameraModel camera = {})
+            : settings(settings),
+              camera(camera) {}
+
+        /**
+         * Feeds one frame of detections, taken at timeMs while the robot was at
+         * (robotX, robotY, robotTheta). robotTheta is in degrees, 0 facing +y and increasing
+         * clockwise, the same as lemlib::Chassis::getPose().
+         */
+        void update(const Detection* detections, size_t count, uint32_t timeMs, float robotX, float robotY,
+                    float robotTheta) {
+            if (count > maxDetections) count = maxDetections;
+            bool used[maxDetections] = {};
+
+            for (size_t t = 0; t < trackCount; t++) {
+                Track& track = tracks[t];
+                float dt = static_cast<float>(timeMs - track.lastSeen);
+                float predictedX = track.cx + track.vx * dt;
+                float predictedY = track.cy + track.vy * dt;
+
+                // best unused detection of the same class for this track
+                int best = -1;
+                float bestScore = 0;
+                for (size_t d = 0; d < count; d++) {
+                    const Detection& det = detections[d];
+                    if (used[d] || det.classId != track.classId) continue;
+                    float iou = overlap(predictedX, predictedY, track.width, track.height, det);
+                    float distance = std::hypot(det.x + det.width / 2 - predictedX, det.y + det.height / 2 - predictedY);
+                    // iou matches always beat distance-only matches
+                    float score = iou >= settings.minIou               ? 1 + iou
+                                  : distance < settings.maxCentreDistance ? 1 - distance / settings.maxCentreDistance
+                                                                          : 0;
+                    if (score > bestScore) {
+                        bestScore = score;
+                        best = static_cast<int>(d);
+                    }
+                }
+
+                if (best < 0) {
+                    track.misses++;
+                    continue;
+                }
+                used[best] = true;
+                const Detection& det = detections[best];
+                float cx = det.x + det.width / 2;
+                float cy = det.y + det.height / 2;
+                if (dt > 0) {
+                    float a = settings.velocitySmoothing;
+                    track.vx = a * (cx - track.cx) / dt + (1 - a) * track.vx;
+                    track.vy = a * (cy - track.cy) / dt + (1 - a) * track.vy;
+                }
+                track.cx = cx;
+                track.cy = cy;
+                track.width = det.width;
+                track.height = det.height;
+                track.misses = 0;
+                if (track.hits < 255) track.hits++;
+                track.lastSeen = timeMs;
+                project(track, robotX, robotY, robotTheta);
+            }
+
+            // drop stale tracks, keeping the array packed
+            size_t kept = 0;
+            for (size_t t = 0; t < trackCount; t++) {
+                if (tracks[t].misses <= settings.maxMisses) tracks[kept++] = tracks[t];
+            }
+            trackCount = kept;
+
+            // unmatched detections start new tracks while there is room
+            for (size_t d = 0; d < count && trackCount < maxTracks; d++) {
+                if (used[d]) continue;
+                const Detection& det = detections[d];
+                Track& track = tracks[trackCount++];
+                track = Track {nextId++, det.classId, 1, 0, det.x + det.width / 2, det.y + det.height / 2, 0, 0,
+                               det.width, det.height, 0, 0, timeMs};
+                project(track, robotX, robotY, robotTheta);
+            }
+        }
+
+        /**
+         * Finds the closest confirmed track of a class to (x, y) on the field. Returns nullptr if none
+         */
+        const Track* nearest(uint8_t classId, float x, float y) const {
+            const Track* best = nullptr;
+            float bestDistance = INFINITY;
+            for (size_t t = 0; t < trackCount; t++) {
+                const Track& track = tracks[t];
+                if (track.classId != classId || !track.confirmed() || track.misses > 0) continue;
+                float distance = std::hypot(track.fieldX - x, track.fieldY - y);
+                if (distance < bestDistance) {
+                    bestDistance = distance;
+                    best = &track;
+                }
+            }
+            return best;
+        }
+
+        size_t size() const { return trackCount; }
+
+        const Track& operator[](size_t index) const { return tracks[index]; }
+
+        void clear() { trackCount = 0; }
+    private:
+        static float overlap(float cx, float cy, float width, float height, const Detection& det) {
+            float left = std::fmax(cx - width / 2, det.x);
+            float right = std::fmin(cx + width / 2, det.x + det.width);
+            float top = std::fmax(cy - height / 2, det.y);
+            float bottom = std::fmin(cy + height / 2, det.y + det.height);
+            if (right <= left || bottom <= top) return 0;
+            float intersection = (right - left) * (bottom - top);
+            return intersection / (width * height + det.width * det.height - intersection);
+        }
+
+        void project(Track& track, float robotX, float robotY, float robotTheta) const {
+            // range from apparent height, bearing from horizontal offset
+            float focal = camera.focal();
+            float range = camera.objectHeight * focal / std::fmax(track.height, 1.0f);
+            float bearing = std::atan2(track.cx - camera.imageWidth / 2, focal);
+            float heading = robotTheta * static_cast<float>(M_PI) / 180;
+            float sinH = std::sin(heading);
+            float cosH = std::cos(heading);
+            // camera position on the field, then out along heading + bearing
+            float camX = robotX + camera.offsetX * cosH + camera.offsetY * sinH;
+            float camY = robotY - camera.offsetX * sinH + camera.offsetY * cosH;
+            track.fieldX = camX + range * std::sin(heading + bearing);
+            track.fieldY = camY + range * std::cos(heading + bearing);
+        }
+
+        TrackerSettings settings;
+        CameraModel camera;
+        Track tracks[maxTracks];
+        size_t trackCount = 0;
+        uint16_t nextId = 1;
+};
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cmath>
+#include "sensor_frame.h"
+
+/*
+ * Odometry that runs on recorded SensorFrames, so estimators can be compared offline
+ * (tools/sensor_replay.cpp). ReferenceOdometry follows lemlib::update() step for step for this
+ * robot's sensors: one vertical tracking wheel and heading from the first IMU's rotation. It
+ * uses floats like lemlib does. This is the only part of the robot replayed offline: lemlib's
+ * motion controllers and the driver's inputs are not re-run, so a replay says nothing about how
+ * the robot would have driven with a different estimator.
+ */
+
+struct OdomConfig {
+    float wheelDiameter = 2.125f; // vertical tracking wheel, inches (lemlib::Omniwheel::NEW_2)
+    float wheelOffset = -1; // inches, as passed to lemlib::TrackingWheel
+    float gearRatio = 1;
+};
+
+struct OdomPose {
+    float x = 0; // inches
+    float y = 0;
+    float theta = 0; // radians, 0 facing +y, clockwise positive (lemlib's internal convention)
+};
+
+/**
+ * Interface for estimators fed from recorded frames
+ */
+class OdomEstimator {
+    public:
+        virtual ~OdomEstimator() = default;
+        /**
+         * Starts from pose (theta in degrees, as lemlib reports it) with frame as the previous reading
+         */
+        virtual void reset(float x, float y, float thetaDeg, const SensorFrame& frame) = 0;
+        virtual void update(const SensorFrame& frame) = 0;
+        virtual OdomPose pose() const = 0;
+};
+
+/**
+ * lemlib's update(): arc from the tracking wheel delta and the IMU heading delta
+ */
+class ReferenceOdometry : public OdomEstimator {
+    public:
+        explicit ReferenceOdometry(OdomConfig config = {})
+            : config(config) {}
+
+        void reset(float x, float y, float thetaDeg, const SensorFrame& frame) override {
+            current = {x, y, thetaDeg * static_cast<float>(M_PI) / 180};
+            prevVertical = wheelDistance(frame);
+            prevImu = imuRadians(frame);
+        }
+
+        void update(const SensorFrame& frame) override {
+            float verticalRaw = wheelDistance(frame);
+            float imuRaw = imuRadians(frame);
+            float deltaVertical = verticalRaw - prevVertical;
+            float deltaImu = imuRaw - prevImu;
+            prevVertical = verticalRaw;
+            prevImu = imuRaw;
+
+            float heading = current.theta + deltaImu;
+            float deltaHeading = heading - current.theta;
+            float avgHeading = current.theta + deltaHeading / 2;
+
+            // no horizontal wheel: lemlib assumes no sideways motion
+            float localX = 0;
+            float localY = deltaVertical;
+            if (deltaHeading != 0) localY = 2 * std::sin(deltaHeading / 2) * (deltaVertical / deltaHeading + config.wheelOffset);
+
+            current.x += localY * std::sin(avgHeading);
+            current.y += localY * std::cos(avgHeading);
+            current.x += localX * -std::cos(avgHeading);
+            current.y += localX * std::sin(avgHeading);
+            current.theta = heading;
+        }
+
+        OdomPose pose() const override { return current; }
+    protected:
+        float wheelDistance(const SensorFrame& frame) const {
+            // lemlib::TrackingWheel::getDistanceTraveled for a rotation sensor
+            return static_cast<float>(frame.rotation) * config.wheelDiameter * static_cast<float>(M_PI) / 36000 /
+                   config.gearRatio;
+        }
+
+        virtual float imuRadians(const SensorFrame& frame) const {
+            return frame.imuRotation[0] * static_cast<float>(M_PI) / 180;
+        }
+
+        OdomConfig config;
+        OdomPose current;
+        float prevVertical = 0;
+        float prevImu = 0;
+};
+
+/**
+ * Same arc model with heading from the mean of both IMUs' rotations, the kind of change worth
+ * checking against real data before putting it on the robot
+ */
+class DualImuOdometry : public ReferenceOdometry {
+    public:
+        using ReferenceOdometry::ReferenceOdometry;
+    protected:
+        float imuRadians(const SensorFrame& frame) const override {
+            return (frame.imuRotation[0] + frame.imuRotation[1]) / 2 * static_cast<float>(M_PI) / 180;
+        }
+};
@@ -0,0 +1,320 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+/*
+ * Collision-free routes across the field for a round robot footprint. Pure C++ with fixed-size
+ * storage, so the same planner runs on Linux to generate auton tables (tools/route_plan.cpp) and
+ * on the brain to replan around a blocked lane (auton::driveTo, auton_actions.h).
+ *
+ * The field is a grid of 2 inch cells. setField() marks the obstacles and computes a distance
+ * field: every cell's clearance to the nearest obstacle or wall. Planning is then A* over the
+ * cells where the robot fits (clearance >= its radius), 8-connected, with steps close to
+ * obstacles made a little more expensive so routes keep some margin. The cell path is pulled
+ * tight into straight legs (each checked against the distance field), so the result is a few
+ * waypoints for moveToPoint, not a staircase.
+ *
+ * Coordinates are field inches from the bottom left corner, x right and y up, as in
+ * FieldMapConfig (field_map.h). The start and the goal may be tighter than the robot's radius
+ * (against a goal or a wall): the route may leave and approach them through tighter space, but
+ * never through cells closer than contactInches to an obstacle, so it cannot cut through one.
+ */
+
+struct FieldRect {
+    float x0; // inches, any corner order
+    float y0;
+    float x1;
+    float y1;
+};
+
+struct PlanPoint {
+    float x;
+    float y;
+};
+
+struct PlanStats {
+    bool found = false;
+    uint32_t expanded = 0; // cells taken off the open list
+    float length = 0; // inches, of the smoothed route
+};
+
+class PathPlanner {
+    public:
+        static constexpr float fieldInches = 144;
+        static constexpr float cellInches = 2;
+        static constexpr int gridSize = static_cast<int>(fieldInches / cellInches);
+        static constexpr int cellCount = gridSize * gridSize;
+        static constexpr size_t maxObstacles = 32;
+        static constexpr float marginInches = 6; // clearance beyond the radius that costs extra
+        static constexpr float contactInches = cellInches; // least clearance anywhere, endpoints included
+
+        /**
+         * Replaces the obstacles and rebuilds the distance field
+         */
+        void setField(const FieldRect* rects, size_t count) {
+            obstacleCount = 0;
+            for (size_t i = 0; i < count && i < maxObstacles; i++) obstacles[obstacleCount++] = normalized(rects[i]);
+            rebuild();
+        }
+
+        /**
+         * Adds an obstacle (a robot parked in a lane, say) and rebuilds. False if the list is full
+         */
+        bool block(const FieldRect& area) {
+            if (obstacleCount == maxObstacles) return false;
+            obstacles[obstacleCount++] = normalized(area);
+            rebuild();
+            return true;
+        }
+
+        /**
+         * Distance from (x, y) to the nearest obstacle or wall, inches
+         */
+        float clearance(float x, float y) const { return distance[cellAt(x, y)]; }
+
+        /**
+         * Plans from start to goal for a robot of the given radius. Writes the waypoints after
+         * start, ending with goal, and returns how many; 0 if there is no route or it needs more
+         * than capacity legs
+         */
+        size_t plan(PlanPoint start, PlanPoint goal, float radius, PlanPoint* out, size_t capacity) {
+            stats = {};
+            startPoint = start;
+            goalPoint = goal;
+            robotRadius = radius;
+            int startCell = cellAt(start.x, start.y);
+            int goalCell = cellAt(goal.x, goal.y);
+            if (!search(startCell, goalCell)) return 0;
+
+            // the cell path, goal to start
+            int16_t* path = heap; // free once the search is over
+            size_t pathLength = 0;
+            for (int cell = goalCell; cell != startCell; cell = parent[cell]) path[pathLength++] = static_cast<int16_t>(cell);
+
+            // pull tight: from each waypoint, the furthest cell still in a straight line of sight
+            PlanPoint from = start;
+            size_t count = 0;
+            size_t index = pathLength; // path[index - 1] is the next cell after from
+            while (index > 0) {
+                size_t furthest = index - 1;
+                for (size_t j = 0; j + 1 < index; j++) {
+                    if (lineClear(from, j == 0 ? goal : center(path[j]))) {
+                        furthest = j;
+                        break;
+                    }
+                }
+                PlanPoint to = furthest == 0 ? goal : center(path[furthest]);
+                if (count == capacity) return 0;
+                out[count++] = to;
+                stats.length += std::hypot(to.x - from.x, to.y - from.y);
+                from = to;
+                index = furthest;
+            }
+            if (count == 0 && capacity > 0) {
+                out[count++] = goal; // start and goal share a cell
+                stats.length = std::hypot(goal.x - start.x, goal.y - start.y);
+            }
+            stats.found = true;
+            return count;
+        }
+
+        const PlanStats& lastStats() const { return stats; }
+    private:
+        static FieldRect normalized(const FieldRect& r) {
+            return {std::fmin(r.x0, r.x1), std::fmin(r.y0, r.y1), std::fmax(r.x0, r.x1), std::fmax(r.y0, r.y1)};
+        }
+
+        static int clampCell(float inches) {
+            int cell = static_cast<int>(std::floor(inches / cellInches));
+            return cell < 0 ? 0 : cell >= gridSize ? gridSize - 1 : cell;
+        }
+
+        static int cellAt(float x, float y) { return clampCell(y) * gridSize + clampCell(x); }
+
+        static PlanPoint center(int cell) {
+            return {(static_cast<float>(cell % gridSize) + 0.5f) * cellInches,
+                    (static_cast<float>(cell / gridSize) + 0.5f) * cellInches};
+        }
+
+        // two-pass chamfer transform from the obstacle cells, then the walls
+        void rebuild() {
+            static constexpr float straight = cellInches;
+            static constexpr float diagonal = cellInches * 1.41421356f;
+            for (int cell = 0; cell < cellCount; cell++) distance[cell] = INFINITY;
+            for (size_t i = 0; i < obstacleCount; i++) {
+                const FieldRect& r = obstacles[i];
+                for (int y = clampCell(r.y0); y <= clampCell(r.y1); y++) {
+                    for (int x = clampCell(r.x0); x <= clampCell(r.x1); x++) distance[y * gridSize + x] = 0;
+                }
+            }
+            for (int y = 0; y < gridSize; y++) {
+                for (int x = 0; x < gridSize; x++) {
+                    float& d = distance[y * gridSize + x];
+                    if (x > 0) d = std::fmin(d, distance[y * gridSize + x - 1] + straight);
+                    if (y > 0) {
+                        d = std::fmin(d, distance[(y - 1) * gridSize + x] + straight);
+                        if (x > 0) d = std::fmin(d, distance[(y - 1) * gridSize + x - 1] + diagonal);
+                        if (x + 1 < gridSize) d = std::fmin(d, distance[(y - 1) * gridSize + x + 1] + diagonal);
+                    }
+                }
+            }
+            for (int y = gridSize - 1; y >= 0; y--) {
+                for (int x = gridSize - 1; x >= 0; x--) {
+                    float& d = distance[y * gridSize + x];
+                    if (x + 1 < gridSize) d = std::fmin(d, distance[y * gridSize + x + 1] + straight);
+                    if (y + 1 < gridSize) {
+                        d = std::fmin(d, distance[(y + 1) * gridSize + x] + straight);
+                        if (x + 1 < gridSize) d = std::fmin(d, distance[(y + 1) * gridSize + x + 1] + diagonal);
+                        if (x > 0) d = std::fmin(d, distance[(y + 1) * gridSize + x - 1] + diagonal);
+                    }
+                }
+            }
+            // distances run between cell centres, an obstacle's edge can be half a cell nearer. The
+            // walls are exact
+            for (int cell = 0; cell < cellCount; cell++) {
+                PlanPoint c = center(cell);
+                float wall = std::fmin(std::fmin(c.x, fieldInches - c.x), std::fmin(c.y, fieldInches - c.y));
+                if (distance[cell] > 0) distance[cell] = std::fmax(0.0f, distance[cell] - cellInches / 2);
+                distance[cell] = std::fmin(distance[cell], wall);
+            }
+        }
+
+        // where the robot may be: where it fits, or within a radius of the start or goal as long as
+        // it stays off the obstacles themselves
+        bool allowed(PlanPoint p) const {
+            float clear = distance[cellAt(p.x, p.y)];
+            if (clear >= robotRadius) return true;
+            if (clear < contactInches) return false;
+            float reach = robotRadius + cellInches;
+            return std::hypot(p.x - startPoint.x, p.y - startPoint.y) < reach ||
+                   std::hypot(p.x - goalPoint.x, p.y - goalPoint.y) < reach;
+        }
+
+        bool lineClear(PlanPoint from, PlanPoint to) const {
+            float length = std::hypot(to.x - from.x, to.y - from.y);
+            int steps = static_cast<int>(std::ceil(length / (cellInches / 2)));
+            for (int i = 1; i <= steps; i++) {
+                float t = static_cast<float>(i) / static_cast<float>(steps);
+                if (!allowed({from.x + (to.x - from.x) * t, from.y + (to.y - from.y) * t})) return false;
+            }
+            return true;
+        }
+
+        float stepCost(int cell, float length) const {
+            float tight = robotRadius + marginInches - distance[cell];
+            return tight > 0 ? length * (1 + tight / marginInches) : length;
+        }
+
+        float heuristic(int cell, int goalCell) const {
+            float dx = std::fabs(static_cast<float>(cell % gridSize - goalCell % gridSize));
+            float dy = std::fabs(static_cast<float>(cell / gridSize - goalCell / gridSize));
+            return (std::fmax(dx, dy) + 0.41421356f * std::fmin(dx, dy)) * cellInches;
+        }
+
+        /* A* */
+        bool search(int startCell, int goalCell) {
+            for (int cell = 0; cell < cellCount; cell++) {
+                state[cell] = UNSEEN;
+                cost[cell] = INFINITY;
+            }
+            heapSize = 0;
+            cost[startCell] = 0;
+            push(startCell, heuristic(startCell, goalCell));
+            static constexpr int dx[] = {1, -1, 0, 0, 1, 1, -1, -1};
+            static constexpr int dy[] = {0, 0, 1, -1, 1, -1, 1, -1};
+            while (heapSize > 0) {
+                int cell = pop();
+                state[cell] = CLOSED;
+                stats.expanded++;
+                if (cell == goalCell) return true;
+                int x = cell % gridSize;
+                int y = cell / gridSize;
+                for (int i = 0; i < 8; i++) {
+                    int nx = x + dx[i];
+                    int ny = y + dy[i];
+                    if (nx < 0 || ny < 0 || nx >= gridSize || ny >= gridSize) continue;
+                    int next = ny * gridSize + nx;
+                    if (state[next] == CLOSED || !allowed(center(next))) continue;
+                    // no cutting corners past a blocked cell
+                    if (i >= 4 && (!allowed(center(y * gridSize + nx)) || !allowed(center(ny * gridSize + x)))) continue;
+                    float g = cost[cell] + stepCost(next, i < 4 ? cellInches : cellInches * 1.41421356f);
+                    if (g >= cost[next]) continue;
+                    cost[next] = g;
+                    parent[next] = static_cast<int16_t>(cell);
+                    float f = g + heuristic(next, goalCell);
+                    if (state[next] == OPEN) decrease(next, f);
+                    else push(next, f);
+                }
+            }
+            return false;
+        }
+
+        // binary min-heap of cells by priority, with each cell's slot tracked for decrease-key
+        void push(int cell, float f) {
+            state[cell] = OPEN;
+            priority[cell] = f;
+            heap[heapSize] = static_cast<int16_t>(cell);
+            slot[cell] = static_cast<int16_t>(heapSize);
+            up(heapSize++);
+        }
+
+        void decrease(int cell, float f) {
+            priority[cell] = f;
+            up(slot[cell]);
+        }
+
+        int pop() {
+            int top = heap[0];
+            heap[0] = heap[--heapSize];
+            slot[heap[0]] = 0;
+            down(0);
+            return top;
+        }
+
+        void swap(size_t a, size_t b) {
+            int16_t cell = heap[a];
+            heap[a] = heap[b];
+            heap[b] = cell;
+            slot[heap[a]] = static_cast<int16_t>(a);
+            slot[heap[b]] = static_cast<int16_t>(b);
+        }
+
+        void up(size_t i) {
+            while (i > 0 && priority[heap[i]] < priority[heap[(i - 1) / 2]]) {
+                swap(i, (i - 1) / 2);
+                i = (i - 1) / 2;
+            }
+        }
+
+        void down(size_t i) {
+            while (true) {
+                size_t smallest = i;
+                size_t left = 2 * i + 1;
+                size_t right = left + 1;
+                if (left < heapSize && priority[heap[left]] < priority[heap[smallest]]) smallest = left;
+                if (right < heapSize && priority[heap[right]] < priority[heap[smallest]]) smallest = right;
+                if (smallest == i) return;
+                swap(i, smallest);
+                i = smallest;
+            }
+        }
+
+        enum : uint8_t { UNSEEN, OPEN, CLOSED };
+
+        FieldRect obstacles[maxObstacles] = {};
+        size_t obstacleCount = 0;
+        float distance[cellCount] = {};
+        float cost[cellCount] = {};
+        float priority[cellCount] = {};
+        int16_t parent[cellCount] = {};
+        int16_t heap[cellCount] = {};
+        int16_t slot[cellCount] = {};
+        uint8_t state[cellCount] = {};
+        size_t heapSize = 0;
+        PlanPoint startPoint = {0, 0};
+        PlanPoint goalPoint = {0, 0};
+        float robotRadius = 0;
+        PlanStats stats;
+};
@@ -0,0 +1,9 @@
+#pragma once
+
+#include "lemlib/pid.hpp"
+
+// lemlib::PID keeps its last error protected. Naming it through a subclass gives a
+// pointer-to-member of the base, which can then be used on any PID (e.g. chassis.lateralPID)
+struct PidErrorProbe : lemlib::PID {
+    static constexpr float lemlib::PID::* prevError = &PidErrorProbe::prevError;
+};
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "main.h"
+
+/*
+ * The chassis pose, speed and motion state, republished every odometry period through a seqlock
+ * (seqlock.h). latestPose() is a few word loads on any task: UI, telemetry and the other
+ * background tasks read it instead of chassis.getPose(), so none of them touch lemlib's state or
+ * the chassis mutex, and the publisher is never held up by a reader.
+ *
+ * Code that needs the pose of this exact instant, like the sensor recorder pairing it with raw
+ * readings, still calls chassis.getPose().
+ *
+ * Snapshots are whole. chassis.getPose() is a plain copy of lemlib's pose with no lock, so the feed
+ * runs one step below lemlib's odometry task (default priority): it never runs while an odometry
+ * update is partway, and each publish pairs the x, y and theta of one update. The autonomous and
+ * driver tasks read at default priority, above the publisher, so a read that finds a publish in
+ * progress sleeps a tick to let it finish instead of spinning (latestPose()).
+ */
+
+struct PoseSnapshot {
+    float x = 0; // inches
+    float y = 0;
+    float theta = 0; // degrees, as chassis.getPose() reports it
+    float xSpeed = 0; // inches per second
+    float ySpeed = 0;
+    float thetaSpeed = 0; // degrees per second
+    bool inMotion = false; // a chassis motion is running
+    uint32_t timeMs = 0; // when it was published
+};
+
+struct PoseFeedStats {
+    uint32_t publishes = 0;
+    uint32_t publishMicros = 0; // last publish, reading lemlib included
+    uint32_t publishMicrosMax = 0;
+    uint32_t readRetries = 0; // reads that overlapped a publish and went again
+};
+
+/**
+ * Publishes every periodMs milliseconds (lemlib's odometry runs every 10) from a task just below
+ * lemlib's odometry task
+ */
+void startPoseFeed(uint32_t periodMs = 10);
+
+/**
+ * The latest published snapshot, never torn. Blocks only if it preempted a publish, for one tick.
+ * All zero before the first publish
+ */
+PoseSnapshot latestPose();
+
+PoseFeedStats getPoseFeedStats();
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <atomic>
+#include "main.h"
+#define FMT_HEADER_ONLY
+#include "fmt/core.h"
+#include "block_log.h"
+
+/**
+ * Streams bytes to the microSD card.
+ *
+ * Each run writes a new /usd/run_NNN.bin. Producers copy into one of two 8 KB buffers and return;
+ * the logger's task writes full buffers in whole 512 byte blocks. A producer never waits on the
+ * card, only on another producer's memcpy, and if the card falls two buffers behind new data is
+ * dropped and counted instead.
+ */
+class SdLogger {
+    public:
+        SdLogger();
+        SdLogger(const SdLogger&) = delete;
+        SdLogger& operator=(const SdLogger&) = delete;
+
+        /**
+         * Opens this run's file. Returns false if there is no card or it could not be opened
+         */
+        bool start();
+
+        bool isOpen() const { return open; }
+
+        /**
+         * Queues bytes for the card. Returns false if they were dropped or the log is not open
+         */
+        bool write(const void* data, size_t length);
+
+        /**
+         * Formats into a stack buffer and queues the result, nothing touches the heap
+         */
+        template <typename... T> bool print(fmt::format_string<T...> format, T&&... args) {
+            char text[256];
+            auto result = fmt::format_to_n(text, sizeof(text), format, std::forward<T>(args)...);
+            return write(text, result.size < sizeof(text) ? result.size : sizeof(text));
+        }
+
+        /**
+         * Asks the task to write out the partly filled buffer and flush the file, e.g. from disabled().
+         * Does not wait for the write
+         */
+        void flush();
+
+        BlockLogStats getStats() { return log.getStats(); }
+    private:
+        void taskLoop();
+
+        BlockLog<pros::Mutex> log;
+        std::atomic<bool> open = false;
+        std::atomic<bool> flushRequested = false;
+        pros::Task task;
+};
+
+/**
+ * The logger for this run, shared by every producer
+ */
+SdLogger& sdLogger();
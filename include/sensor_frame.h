@@ -0,0 +1,107 @@
+#pragma once
+
+#include "telemetry_protocol.h"
+
+/*
+ * One timestamped snapshot of every sensor odometry and driver control read, recorded on the
+ * robot by src/sensor_recorder.cpp and replayed on Linux by tools/sensor_replay.cpp.
+ *
+ * raw frame:  [0xF1][time_ms u32][rotation centideg i32][imu rotation f32 x2][imu heading f32 x2]
+ *             [drive motor position f32 x6][controller axes i8 x4][buttons u16][lemlib pose f32 x3][crc16]
+ *
+ * Frames are COBS encoded and 0x00 delimited like telemetry and log frames, so all three can
+ * share a capture; the 0xF1 marker is neither a telemetry channel nor a log frame.
+ */
+
+constexpr uint8_t sensorFrameMarker = 0xF1;
+constexpr size_t sensorFrameRawSize = 1 + 4 + 4 + 8 + 8 + 24 + 4 + 2 + 12 + 2;
+constexpr size_t sensorMaxFrameSize = sensorFrameRawSize + sensorFrameRawSize / 254 + 3;
+
+/**
+ * Bits of SensorFrame::buttons
+ */
+enum SensorButton : uint16_t {
+    SENSOR_BUTTON_L1 = 1 << 0,
+    SENSOR_BUTTON_L2 = 1 << 1,
+    SENSOR_BUTTON_R1 = 1 << 2,
+    SENSOR_BUTTON_R2 = 1 << 3,
+    SENSOR_BUTTON_A = 1 << 4,
+    SENSOR_BUTTON_B = 1 << 5,
+    SENSOR_BUTTON_X = 1 << 6,
+    SENSOR_BUTTON_Y = 1 << 7,
+    SENSOR_BUTTON_UP = 1 << 8,
+    SENSOR_BUTTON_DOWN = 1 << 9,
+    SENSOR_BUTTON_LEFT = 1 << 10,
+    SENSOR_BUTTON_RIGHT = 1 << 11
+};
+
+struct SensorFrame {
+    uint32_t time = 0; // ms
+    int32_t rotation = 0; // vertical tracking wheel, centidegrees
+    float imuRotation[2] = {}; // unbounded degrees, imu then imu2
+    float imuHeading[2] = {}; // [0, 360)
+    float drivePosition[6] = {}; // degrees, left motors then right motors
+    int8_t axes[4] = {}; // left x, left y, right x, right y
+    uint16_t buttons = 0; // SensorButton bits
+    float poseX = 0; // what lemlib's odometry reported at the same time, inches
+    float poseY = 0;
+    float poseTheta = 0; // degrees
+};
+
+namespace sensor_frame_detail {
+template <typename T> inline void put(uint8_t* raw, size_t& offset, const T& value) {
+    std::memcpy(raw + offset, &value, sizeof(T));
+    offset += sizeof(T);
+}
+
+template <typename T> inline void get(const uint8_t* raw, size_t& offset, T& value) {
+    std::memcpy(&value, raw + offset, sizeof(T));
+    offset += sizeof(T);
+}
+} // namespace sensor_frame_detail
+
+/**
+ * Encodes frame into out (sensorMaxFrameSize bytes), including the delimiters. Returns the length
+ */
+inline size_t encodeSensorFrame(const SensorFrame& frame, uint8_t* out) {
+    using sensor_frame_detail::put;
+    uint8_t raw[sensorFrameRawSize];
+    size_t offset = 0;
+    put(raw, offset, sensorFrameMarker);
+    put(raw, offset, frame.time);
+    put(raw, offset, frame.rotation);
+    put(raw, offset, frame.imuRotation);
+    put(raw, offset, frame.imuHeading);
+    put(raw, offset, frame.drivePosition);
+    put(raw, offset, frame.axes);
+    put(raw, offset, frame.buttons);
+    put(raw, offset, frame.poseX);
+    put(raw, offset, frame.poseY);
+    put(raw, offset, frame.poseTheta);
+    put(raw, offset, crc16Ccitt(raw, offset));
+    return encodeWireFrame(raw, offset, out);
+}
+
+/**
+ * Decodes a frame without its delimiter. Returns false if it is not a valid sensor frame
+ */
+inline bool decodeSensorFrame(const uint8_t* data, size_t length, SensorFrame& frame) {
+    using sensor_frame_detail::get;
+    uint8_t raw[sensorFrameRawSize];
+    if (cobsDecode(data, length, raw, sizeof(raw)) != sensorFrameRawSize || raw[0] != sensorFrameMarker) return false;
+    uint16_t crc;
+    std::memcpy(&crc, raw + sensorFrameRawSize - 2, 2);
+    if (crc != crc16Ccitt(raw, sensorFrameRawSize - 2)) return false;
+    size_t offset = 1;
+    get(raw, offset, frame.time);
+    get(raw, offset, frame.rotation);
+    get(raw, offset, frame.imuRotation);
+    get(raw, offset, frame.imuHeading);
+    get(raw, offset, frame.drivePosition);
+    get(raw, offset, frame.axes);
+    get(raw, offset, frame.buttons);
+    get(raw, offset, frame.poseX);
+    get(raw, offset, frame.poseY);
+    get(raw, offset, frame.poseTheta);
+    return true;
+}
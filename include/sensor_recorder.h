@@ -0,0 +1,17 @@
+#pragma once
+
+#include "main.h"
+#include "sensor_frame.h"
+
+/**
+ * Starts recording every sensor odometry and driver control read (see sensor_frame.h), every
+ * periodMs milliseconds, to the SD logger's file. Replay it on Linux with tools/sensor_replay.
+ *
+ * periodMs should match lemlib's odometry task (10 ms) so replayed estimators see the same steps.
+ */
+void startSensorRecording(uint32_t periodMs = 10);
+
+/**
+ * Frames recorded so far
+ */
+uint32_t getSensorFramesRecorded();
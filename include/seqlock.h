@@ -0,0 +1,68 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+/*
+ * Single-writer, many-reader publication of a small value. The writer never waits: it bumps the
+ * sequence to odd, stores the value, and bumps it back to even. A reader copies the value and
+ * retries if the sequence was odd or changed meanwhile, so it never sees a torn value and never
+ * holds anything the writer could wait on. PROS-free so tools/pose_contention_bench can run it.
+ *
+ * The value is stored as relaxed atomic words rather than plain memory, which keeps a reader's
+ * copy racing a write well defined. Only one task may call publish(). On a single core the writer
+ * must not be preempted by a reader mid-publish, or that reader spins until the writer runs again:
+ * publish from a task with a higher priority than every reader, or have readers that outrank it
+ * loop on tryRead() and sleep when it keeps failing (pose_feed.cpp).
+ */
+
+template <typename T> class Seqlock {
+        static_assert(std::is_trivially_copyable_v<T>, "Seqlock values are copied word by word");
+        static constexpr size_t wordCount = (sizeof(T) + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+    public:
+        void publish(const T& value) {
+            uint32_t buffer[wordCount] = {};
+            memcpy(buffer, &value, sizeof(T));
+            uint32_t sequence = sequenceNumber.load(std::memory_order_relaxed);
+            sequenceNumber.store(sequence + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            for (size_t i = 0; i < wordCount; i++) words[i].store(buffer[i], std::memory_order_relaxed);
+            sequenceNumber.store(sequence + 2, std::memory_order_release);
+        }
+
+        /**
+         * One attempt at a consistent copy. False if a publish() overlapped it
+         */
+        bool tryRead(T& value) const {
+            uint32_t before = sequenceNumber.load(std::memory_order_acquire);
+            if (before & 1) return false;
+            uint32_t buffer[wordCount];
+            for (size_t i = 0; i < wordCount; i++) buffer[i] = words[i].load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (sequenceNumber.load(std::memory_order_relaxed) != before) return false;
+            memcpy(&value, buffer, sizeof(T));
+            return true;
+        }
+
+        /**
+         * Retries until a copy is consistent. retries, if given, counts the failed attempts
+         */
+        T read(uint32_t* retries = nullptr) const {
+            T value;
+            while (!tryRead(value)) {
+                if (retries != nullptr) (*retries)++;
+            }
+            return value;
+        }
+
+        /**
+         * Number of completed publish() calls
+         */
+        uint32_t version() const { return sequenceNumber.load(std::memory_order_acquire) / 2; }
+    private:
+        std::atomic<uint32_t> sequenceNumber = 0;
+        std::atomic<uint32_t> words[wordCount] = {};
+};
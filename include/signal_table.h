@@ -0,0 +1,127 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/*
+ * Registry of named signals sampled together at a fixed rate into a columnar ring. Pure C++ so
+ * tools can use it; the robot's table and sampler task live in signals.h.
+ *
+ * One task calls sample(), which reads every signal once and publishes the row. Consumers (LCD,
+ * serial, SD, ...) each keep a SignalCursor and pull rows at their own decimation, so the cost
+ * of sampling does not depend on how many consumers there are. A consumer that falls more than
+ * depth rows behind skips ahead to the oldest row still held and counts what it missed.
+ */
+
+using SignalFn = float (*)();
+using SignalId = uint8_t;
+
+struct SignalInfo {
+    const char* name;
+    const char* unit;
+    SignalFn read;
+};
+
+/**
+ * A consumer's position in the ring. decimation 1 takes every row, 10 every tenth row
+ */
+struct SignalCursor {
+    uint32_t decimation = 1;
+    uint32_t next = 0; // sequence number of the next row to take
+    uint32_t skipped = 0; // rows lost because the consumer fell behind
+};
+
+template <size_t maxSignals = 32, size_t depth = 128> class SignalTable {
+        static_assert((depth & (depth - 1)) == 0, "depth must be a power of two");
+    public:
+        static constexpr size_t capacity = maxSignals;
+
+        /**
+         * Registers a signal and returns its column. Register everything before sampling starts.
+         * Returns maxSignals if the table is full
+         */
+        SignalId add(const char* name, const char* unit, SignalFn read) {
+            size_t index = count.load(std::memory_order_relaxed);
+            if (index >= maxSignals) return maxSignals;
+            signals[index] = {name, unit, read};
+            count.store(index + 1, std::memory_order_release);
+            return static_cast<SignalId>(index);
+        }
+
+        size_t size() const { return count.load(std::memory_order_acquire); }
+
+        const SignalInfo& info(SignalId id) const { return signals[id]; }
+
+        /**
+         * Reads every signal into a new row. Call from one task only
+         */
+        void sample(uint32_t timeMs) {
+            uint32_t sequence = published.load(std::memory_order_relaxed);
+            size_t row = sequence & (depth - 1);
+            size_t n = size();
+            // mark the row as being rewritten, so a reader copying it can tell
+            rowSequence[row].store(~0u, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            times[row] = timeMs;
+            for (size_t i = 0; i < n; i++) columns[i][row] = signals[i].read();
+            rowSequence[row].store(sequence, std::memory_order_release);
+            published.store(sequence + 1, std::memory_order_release);
+        }
+
+        /**
+         * Number of rows sampled so far
+         */
+        uint32_t sampleCount() const { return published.load(std::memory_order_acquire); }
+
+        /**
+         * Copies the cursor's next row into values (size() floats) and advances it by its
+         * decimation. Returns false if no new row is available yet
+         */
+        bool read(SignalCursor& cursor, uint32_t& timeMs, float* values) const {
+            while (true) {
+                uint32_t newest = sampleCount();
+                if (static_cast<int32_t>(cursor.next - newest) >= 0) return false;
+                if (newest - cursor.next > depth - 1) {
+                    // lapped, the rows in between are gone. Keep one row of slack for the writer
+                    uint32_t oldest = newest - (depth - 1);
+                    cursor.skipped += oldest - cursor.next;
+                    cursor.next = oldest;
+                }
+                if (copyRow(cursor.next, timeMs, values)) {
+                    cursor.next += cursor.decimation == 0 ? 1 : cursor.decimation;
+                    return true;
+                }
+            }
+        }
+
+        /**
+         * Copies the newest row, for consumers that only want the current value
+         */
+        bool latest(uint32_t& timeMs, float* values) const {
+            for (int attempt = 0; attempt < 4; attempt++) {
+                uint32_t newest = sampleCount();
+                if (newest == 0) return false;
+                if (copyRow(newest - 1, timeMs, values)) return true;
+            }
+            return false;
+        }
+    private:
+        bool copyRow(uint32_t sequence, uint32_t& timeMs, float* values) const {
+            size_t row = sequence & (depth - 1);
+            if (rowSequence[row].load(std::memory_order_acquire) != sequence) return false;
+            size_t n = size();
+            timeMs = times[row];
+            for (size_t i = 0; i < n; i++) values[i] = columns[i][row];
+            std::atomic_thread_fence(std::memory_order_acquire);
+            // the sampler may have started on this row while it was copied
+            return rowSequence[row].load(std::memory_order_relaxed) == sequence;
+        }
+
+        SignalInfo signals[maxSignals] = {};
+        std::atomic<size_t> count = 0;
+        std::atomic<uint32_t> published = 0;
+        std::atomic<uint32_t> rowSequence[depth] = {};
+        uint32_t times[depth] = {};
+        float columns[maxSignals][depth] = {}; // one contiguous column per signal
+};
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "main.h"
+#include "signal_table.h"
+
+/**
+ * Where sampled signals can be sent. The brain screen reads the table itself, see dashboard.h
+ */
+enum class SignalOutput {
+    SERIAL, // "S,time,values..." csv lines on stdout
+    SD // the same csv lines on the microSD card, see sd_logger.h
+};
+
+/**
+ * The robot's signal table. Signals are declared in src/signals.cpp
+ */
+SignalTable<>& signalTable();
+
+/**
+ * Registers the robot's signals and starts sampling all of them every periodMs milliseconds
+ */
+void startSignalSampler(uint32_t periodMs = 10);
+
+/**
+ * Sends every decimation-th sample to an output. The first call starts the (low priority)
+ * consumer task; the sampler does the same work however many outputs are running
+ */
+void startSignalOutput(SignalOutput output, uint32_t decimation);
@@ -0,0 +1,286 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/*
+ * Robot-to-robot state sharing codec. Pure C++ so it can run on the brain (src/link_sync.cpp)
+ * and on Linux (tools/state_sync_loopback.cpp).
+ *
+ * Every packet is exactly statePacketSize bytes so the receiver never has to guess a length:
+ *
+ *   header  [flags][seq][time_ms u16][mechanism]        flags: bit7 = keyframe, bits3-6 = keyframe id,
+ *                                                       bits0-2 = path count
+ *   KEY     [x i16][y i16][theta u16][2 path pts][pad]  x/y in 1/100 in, theta in 1/65536 turn
+ *   DELTA   [dx i8][dy i8][dtheta i8][4 path pts]       dx/dy in 1/4 in, dtheta in deg
+ *
+ * Path points are (i8, i8) offsets from the pose in whole inches. Every delta is taken against
+ * the last keyframe (named by its id), not the previous packet: a lost delta costs only itself,
+ * and only a lost keyframe makes the decoder ignore deltas until the next one. A pose more than
+ * ~31 in or 127 deg from the keyframe is sent as a new keyframe.
+ */
+
+constexpr size_t statePacketSize = 16;
+constexpr uint8_t syncMaxPathPoints = 4;
+
+/* STATE */
+struct SyncPoint {
+    float x;
+    float y;
+};
+
+struct RobotSyncState {
+    float x = 0; // inches
+    float y = 0; // inches
+    float theta = 0; // degrees
+    uint8_t mechanism = 0; // bitfield, meaning is up to the robots
+    uint8_t pathCount = 0;
+    SyncPoint path[syncMaxPathPoints] = {}; // next targets, in field coordinates
+};
+
+struct SyncStats {
+    uint32_t sent = 0;
+    uint32_t keyframesSent = 0;
+    uint32_t received = 0;
+    uint32_t lost = 0; // sequence gaps
+    uint32_t discarded = 0; // deltas dropped because their keyframe was lost
+    uint32_t latencyMin = 0; // ms above the fastest packet seen, see StateSyncDecoder
+    uint32_t latencyMax = 0;
+    float latencyAvg = 0;
+};
+
+/* QUANTIZATION */
+namespace sync_detail {
+constexpr uint8_t keyFlag = 0x80;
+constexpr uint8_t keyIdShift = 3;
+constexpr uint8_t keyIdMask = 0x0F;
+
+inline int32_t quantize(float value, float scale) { return static_cast<int32_t>(std::lround(value * scale)); }
+
+inline uint16_t quantizeTheta(float degrees) {
+    float turns = degrees / 360.0f;
+    turns -= std::floor(turns);
+    return static_cast<uint16_t>(std::lround(turns * 65536.0f) & 0xFFFF);
+}
+
+inline int16_t read16(const uint8_t* p) {
+    int16_t value;
+    std::memcpy(&value, p, 2);
+    return value;
+}
+
+inline void write16(uint8_t* p, int32_t value) {
+    int16_t v = static_cast<int16_t>(value);
+    std::memcpy(p, &v, 2);
+}
+
+inline bool fitsInt8(int32_t value) { return value >= -127 && value <= 127; }
+
+inline int8_t pathOffset(float point, float pose) {
+    float offset = std::round(point - pose);
+    return static_cast<int8_t>(offset > 127 ? 127 : offset < -127 ? -127 : offset);
+}
+} // namespace sync_detail
+
+/* ENCODER */
+class StateSyncEncoder {
+    public:
+        /**
+         * @param keyframeInterval send a keyframe at least this often, bounds how long a loss lasts
+         */
+        explicit StateSyncEncoder(uint8_t keyframeInterval = 10)
+            : keyframeInterval(keyframeInterval) {}
+
+        /**
+         * Encodes state into exactly statePacketSize bytes at out
+         */
+        void encode(const RobotSyncState& state, uint32_t timeMs, uint8_t* out) {
+            using namespace sync_detail;
+            int32_t qx = quantize(state.x, 100);
+            int32_t qy = quantize(state.y, 100);
+            uint16_t qth = quantizeTheta(state.theta);
+            // deltas are taken against the keyframe as the decoder holds it
+            int32_t dx = quantize(state.x - refX / 100.0f, 4);
+            int32_t dy = quantize(state.y - refY / 100.0f, 4);
+            int32_t dth = quantize(static_cast<int16_t>(qth - refTheta) * 360.0f / 65536.0f, 1);
+            bool key = !hasReference || sinceKey >= keyframeInterval || !fitsInt8(dx) || !fitsInt8(dy)
+                       || !fitsInt8(dth);
+
+            std::memset(out, 0, statePacketSize);
+            uint8_t maxPath = key ? 2 : syncMaxPathPoints;
+            uint8_t pathCount = state.pathCount < maxPath ? state.pathCount : maxPath;
+            if (key) keyId = static_cast<uint8_t>((keyId + 1) & keyIdMask);
+            out[0] = static_cast<uint8_t>((key ? keyFlag : 0) | keyId << keyIdShift | pathCount);
+            out[1] = seq++;
+            write16(out + 2, static_cast<int32_t>(timeMs & 0xFFFF));
+            out[4] = state.mechanism;
+
+            uint8_t* path;
+            if (key) {
+                write16(out + 5, qx);
+                write16(out + 7, qy);
+                write16(out + 9, qth);
+                path = out + 11;
+                refX = static_cast<int16_t>(qx);
+                refY = static_cast<int16_t>(qy);
+                refTheta = qth;
+                hasReference = true;
+                sinceKey = 0;
+                stats.keyframesSent++;
+            } else {
+                out[5] = static_cast<uint8_t>(static_cast<int8_t>(dx));
+                out[6] = static_cast<uint8_t>(static_cast<int8_t>(dy));
+                out[7] = static_cast<uint8_t>(static_cast<int8_t>(dth));
+                path = out + 8;
+                sinceKey++;
+            }
+            for (uint8_t i = 0; i < pathCount; i++) {
+                path[i * 2] = static_cast<uint8_t>(pathOffset(state.path[i].x, state.x));
+                path[i * 2 + 1] = static_cast<uint8_t>(pathOffset(state.path[i].y, state.y));
+            }
+            stats.sent++;
+        }
+
+        SyncStats stats;
+    private:
+        uint8_t keyframeInterval;
+        uint8_t sinceKey = 0;
+        uint8_t keyId = 0;
+        uint8_t seq = 0;
+        bool hasReference = false;
+        int32_t refX = 0;
+        int32_t refY = 0;
+        uint16_t refTheta = 0;
+};
+
+/* DECODER */
+class StateSyncDecoder {
+    public:
+        /**
+         * Applies one packet. Returns true if state now holds a fresh partner state.
+         *
+         * The two brains' clocks are not synchronized, so latency is reported relative to the
+         * fastest packet seen so far: 0 means "as fast as the link has ever been".
+         */
+        bool decode(const uint8_t* packet, uint32_t nowMs, RobotSyncState& state) {
+            using namespace sync_detail;
+            bool key = packet[0] & keyFlag;
+            uint8_t packetKeyId = (packet[0] >> keyIdShift) & keyIdMask;
+            uint8_t packetSeq = packet[1];
+            if (hasSeq && packetSeq != static_cast<uint8_t>(lastSeq + 1)) {
+                stats.lost += static_cast<uint8_t>(packetSeq - lastSeq - 1);
+            }
+            hasSeq = true;
+            lastSeq = packetSeq;
+            stats.received++;
+            recordLatency(static_cast<uint16_t>(read16(packet + 2)), nowMs);
+
+            const uint8_t* path;
+            if (key) {
+                refX = read16(packet + 5);
+                refY = read16(packet + 7);
+                refTheta = static_cast<uint16_t>(read16(packet + 9));
+                refKeyId = packetKeyId;
+                path = packet + 11;
+                synced = true;
+                state.x = refX / 100.0f;
+                state.y = refY / 100.0f;
+                state.theta = refTheta * 360.0f / 65536.0f;
+            } else {
+                // a delta against a keyframe we never got
+                if (!synced || packetKeyId != refKeyId) {
+                    stats.discarded++;
+                    return false;
+                }
+                state.x = refX / 100.0f + static_cast<int8_t>(packet[5]) / 4.0f;
+                state.y = refY / 100.0f + static_cast<int8_t>(packet[6]) / 4.0f;
+                float theta = refTheta * 360.0f / 65536.0f + static_cast<int8_t>(packet[7]);
+                state.theta = theta - 360.0f * std::floor(theta / 360.0f);
+                path = packet + 8;
+            }
+            state.mechanism = packet[4];
+            state.pathCount = packet[0] & 0x07;
+            if (state.pathCount > syncMaxPathPoints) state.pathCount = syncMaxPathPoints;
+            for (uint8_t i = 0; i < state.pathCount; i++) {
+                state.path[i].x = state.x + static_cast<int8_t>(path[i * 2]);
+                state.path[i].y = state.y + static_cast<int8_t>(path[i * 2 + 1]);
+            }
+            return true;
+        }
+
+        SyncStats stats;
+    private:
+        void recordLatency(uint16_t sentMs, uint32_t nowMs) {
+            // wrapping 16 bit difference between the two clocks
+            int32_t offset = static_cast<int16_t>(static_cast<uint16_t>(nowMs) - sentMs);
+            if (!hasOffset || offset < minOffset) {
+                // a faster packet moves the baseline, shift the history with it
+                uint32_t shift = hasOffset ? static_cast<uint32_t>(minOffset - offset) : 0;
+                stats.latencyMin += shift;
+                stats.latencyMax += shift;
+                stats.latencyAvg += shift;
+                minOffset = offset;
+                hasOffset = true;
+            }
+            uint32_t latency = static_cast<uint32_t>(offset - minOffset);
+            if (stats.received == 1 || latency < stats.latencyMin) stats.latencyMin = latency;
+            if (latency > stats.latencyMax) stats.latencyMax = latency;
+            stats.latencyAvg += (latency - stats.latencyAvg) / stats.received;
+        }
+
+        bool hasSeq = false;
+        bool synced = false;
+        bool hasOffset = false;
+        uint8_t lastSeq = 0;
+        uint8_t refKeyId = 0;
+        int32_t minOffset = 0;
+        int32_t refX = 0;
+        int32_t refY = 0;
+        uint16_t refTheta = 0;
+};
+
+/* TRANSPORTS */
+class SyncTransport {
+    public:
+        virtual ~SyncTransport() = default;
+        /** sends one statePacketSize packet, returns false if the link could not take it */
+        virtual bool send(const uint8_t* packet) = 0;
+        /** reads one statePacketSize packet into out, returns false if none is waiting */
+        virtual bool receive(uint8_t* out) = 0;
+};
+
+/**
+ * In-process stand-in for a radio link. Packets sent through one end come out of the other,
+ * with an optional deterministic loss pattern for testing.
+ */
+class LoopbackTransport : public SyncTransport {
+    public:
+        /** @param dropEvery drop every nth packet, 0 for a perfect link */
+        explicit LoopbackTransport(uint32_t dropEvery = 0)
+            : dropEvery(dropEvery) {}
+
+        bool send(const uint8_t* packet) override {
+            if (dropEvery != 0 && ++sendCount % dropEvery == 0) return true;
+            if (count == capacity) return false;
+            std::memcpy(queue[(head + count) % capacity], packet, statePacketSize);
+            count++;
+            return true;
+        }
+
+        bool receive(uint8_t* out) override {
+            if (count == 0) return false;
+            std::memcpy(out, queue[head], statePacketSize);
+            head = (head + 1) % capacity;
+            count--;
+            return true;
+        }
+    private:
+        static constexpr size_t capacity = 32;
+        uint8_t queue[capacity][statePacketSize];
+        size_t head = 0;
+        size_t count = 0;
+        uint32_t dropEvery;
+        uint32_t sendCount = 0;
+};
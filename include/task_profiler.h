@@ -0,0 +1,63 @@
+#pragma once
+
+#include "main.h"
+
+/*
+ * Periodic per-task profile: state, priority, stack high water mark and CPU share, with a
+ * min/avg/max history of CPU share since the profiler started.
+ *
+ * PROS has no call that lists tasks, so tasks are found by name: every task this project starts
+ * is profiled by default and profileTask() adds others. The report says how many of
+ * task_get_count() tasks it covers. Stack high water marks and run time counters come from the
+ * FreeRTOS kernel PROS is built on, through names PROS does not declare; a kernel without them
+ * reports those columns as -1 and the profiler logs a warning when it starts. Per task CPU share
+ * is of the profiled tasks' time only.
+ *
+ * cpu_busy does not use the kernel's counters: a "CPU Probe" task just above the idle task
+ * measures how much of the wall time it could not get, which covers every task, lemlib's included.
+ */
+
+struct TaskProfile {
+    const char* name = nullptr;
+    bool found = false; // a task with this name exists
+    uint32_t priority = 0;
+    pros::task_state_e_t state = pros::E_TASK_STATE_INVALID;
+    int32_t stackFreeWords = -1; // least free stack the task has ever had, -1 if not available
+    float cpu = -1; // percent of the last period, -1 if not available
+    float cpuMin = -1;
+    float cpuAvg = -1;
+    float cpuMax = -1;
+};
+
+/**
+ * Adds a task to profile by name (static storage, e.g. a string literal). Call before
+ * startTaskProfiler()
+ */
+void profileTask(const char* name);
+
+/**
+ * Samples every profiled task each periodMs milliseconds and writes a "P,..." csv line per task
+ * to the SD logger every reportEvery periods
+ */
+void startTaskProfiler(uint32_t periodMs = 1000, uint32_t reportEvery = 5);
+
+/**
+ * Copies up to capacity profiles into out. Returns how many were copied
+ */
+size_t getTaskProfiles(TaskProfile* out, size_t capacity);
+
+/**
+ * Percent of wall time over the last period that any task or interrupt other than the CPU probe
+ * had the CPU, -1 until the first period has been measured
+ */
+float getCpuBusy();
+
+/**
+ * Least free stack across the profiled tasks, in words. -1 if not available
+ */
+int32_t getMinStackFree();
+
+/**
+ * Prints the table to stdout, e.g. from disabled()
+ */
+void printTaskProfiles();
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "main.h"
+#include "pros/serial.hpp"
+#include "bounded_buffer.h"
+#include "telemetry_protocol.h"
+
+/**
+ * Sends one binary telemetry sample (see telemetry_protocol.h) over the telemetry output.
+ * values must point to count elements of the channel's type. Safe to call from any task.
+ *
+ * Frames are queued in a fixed-size buffer and written in batches. When the link cannot keep up,
+ * the oldest frames are dropped. If the SD logger is running, every frame is also written to the card.
+ */
+void sendTelemetry(TelemetryChannel channel, const void* values, uint8_t count);
+
+/**
+ * Queue counters for the telemetry output, including frames dropped because the link was full
+ */
+BufferStats getTelemetryBufferStats();
+
+/**
+ * Adds the executor job (executor.h) that streams pose, PID error, motor voltages and its own loop timing
+ * every periodMs milliseconds.
+ *
+ * Frames go to stdout by default. Pass a pros::Serial to send them out of a smart port instead.
+ */
+void startTelemetryStream(uint32_t periodMs = 10, pros::Serial* serial = nullptr);
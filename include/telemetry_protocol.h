@@ -0,0 +1,174 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/*
+ * Binary telemetry wire format, shared by the robot (src/telemetry.cpp) and the
+ * host decoder (tools/telemetry_decode.cpp). Nothing in here may depend on PROS.
+ *
+ * raw frame:     [channel u8][seq u8][time_ms u32][count u8][values...][crc16 u16]
+ * on the wire:   0x00, COBS(raw frame), 0x00
+ *
+ * All multi-byte fields are little endian. The CRC is CRC-16/CCITT-FALSE over
+ * every byte before it. Each channel has a fixed value type, so a pose sample is
+ * 24 bytes on the wire instead of ~60 bytes of formatted text.
+ *
+ * The leading 0x00 closes whatever came before the frame on a shared stream (a printf line,
+ * logger text) so that text is one bad chunk to the decoder instead of swallowing the frame.
+ */
+
+/* CHANNELS */
+enum class TelemetryChannel : uint8_t {
+    POSE = 1, // x, y, theta (f32)
+    PID_ERROR = 2, // lateral, angular (f32)
+    MOTOR_VOLTAGE = 3, // left motors then right motors, in mV (i16)
+    LOOP_TIMING = 4, // period, execution time, in us (u32)
+};
+
+enum class TelemetryType : uint8_t { F32, I16, U32 };
+
+struct TelemetryChannelInfo {
+    TelemetryChannel channel;
+    const char* name;
+    TelemetryType type;
+    const char* columns; // comma separated, used as the csv header by the decoder
+};
+
+inline constexpr TelemetryChannelInfo telemetryChannels[] = {
+    {TelemetryChannel::POSE, "pose", TelemetryType::F32, "x,y,theta"},
+    {TelemetryChannel::PID_ERROR, "pid_error", TelemetryType::F32, "lateral,angular"},
+    {TelemetryChannel::MOTOR_VOLTAGE, "motor_voltage", TelemetryType::I16, "l1,l2,l3,r1,r2,r3"},
+    {TelemetryChannel::LOOP_TIMING, "loop_timing", TelemetryType::U32, "period_us,exec_us"},
+};
+
+/* SIZES */
+constexpr size_t telemetryMaxValues = 8;
+constexpr size_t telemetryHeaderSize = 7;
+constexpr size_t telemetryMaxRawSize = telemetryHeaderSize + telemetryMaxValues * 4 + 2;
+// COBS adds at most one byte per 254 plus the leading code byte, then the two 0x00 delimiters
+constexpr size_t telemetryMaxFrameSize = telemetryMaxRawSize + telemetryMaxRawSize / 254 + 3;
+
+inline const TelemetryChannelInfo* telemetryChannelInfo(uint8_t channel) {
+    for (const TelemetryChannelInfo& info : telemetryChannels) {
+        if (static_cast<uint8_t>(info.channel) == channel) return &info;
+    }
+    return nullptr;
+}
+
+inline constexpr size_t telemetryTypeSize(TelemetryType type) {
+    return type == TelemetryType::I16 ? 2 : 4;
+}
+
+/* CRC */
+inline uint16_t crc16Ccitt(const uint8_t* data, size_t length) {
+    uint16_t crc = 0xFFFF;
+    for (size_t i = 0; i < length; i++) {
+        crc ^= static_cast<uint16_t>(data[i]) << 8;
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x8000) ? static_cast<uint16_t>((crc << 1) ^ 0x1021) : static_cast<uint16_t>(crc << 1);
+        }
+    }
+    return crc;
+}
+
+/* COBS */
+// encodes length bytes of src into dst (no delimiter), returns the encoded length.
+// dst must hold at least length + length / 254 + 1 bytes
+inline size_t cobsEncode(const uint8_t* src, size_t length, uint8_t* dst) {
+    size_t codeIndex = 0;
+    size_t out = 1;
+    uint8_t code = 1;
+    for (size_t i = 0; i < length; i++) {
+        if (src[i] == 0) {
+            dst[codeIndex] = code;
+            codeIndex = out++;
+            code = 1;
+            continue;
+        }
+        dst[out++] = src[i];
+        if (++code == 0xFF) {
+            dst[codeIndex] = code;
+            codeIndex = out++;
+            code = 1;
+        }
+    }
+    dst[codeIndex] = code;
+    return out;
+}
+
+// decodes a frame without its delimiter, returns the decoded length or 0 if the frame is malformed
+inline size_t cobsDecode(const uint8_t* src, size_t length, uint8_t* dst, size_t capacity) {
+    size_t in = 0;
+    size_t out = 0;
+    while (in < length) {
+        uint8_t code = src[in++];
+        if (code == 0 || in + code - 1 > length) return 0;
+        for (uint8_t i = 1; i < code; i++) {
+            if (out >= capacity) return 0;
+            dst[out++] = src[in++];
+        }
+        if (code != 0xFF && in < length) {
+            if (out >= capacity) return 0;
+            dst[out++] = 0;
+        }
+    }
+    return out;
+}
+
+// COBS encodes length bytes of raw into out between two 0x00 delimiters, returns the wire length.
+// out must hold length + length / 254 + 3 bytes. Every frame type on a shared stream goes through this
+inline size_t encodeWireFrame(const uint8_t* raw, size_t length, uint8_t* out) {
+    out[0] = 0;
+    size_t encoded = 1 + cobsEncode(raw, length, out + 1);
+    out[encoded++] = 0;
+    return encoded;
+}
+
+/* FRAMES */
+struct TelemetrySample {
+    TelemetryChannel channel;
+    uint8_t seq;
+    uint32_t time;
+    uint8_t count;
+    uint8_t values[telemetryMaxValues * 4]; // little endian, element type given by the channel
+};
+
+// builds a complete wire frame (including both 0x00 delimiters) into out, returns its length or 0 on bad input.
+// out must hold telemetryMaxFrameSize bytes
+inline size_t encodeTelemetryFrame(TelemetryChannel channel, uint8_t seq, uint32_t time, const void* values,
+                                   uint8_t count, uint8_t* out) {
+    const TelemetryChannelInfo* info = telemetryChannelInfo(static_cast<uint8_t>(channel));
+    if (info == nullptr || count > telemetryMaxValues) return 0;
+    uint8_t raw[telemetryMaxRawSize];
+    size_t payload = count * telemetryTypeSize(info->type);
+    raw[0] = static_cast<uint8_t>(channel);
+    raw[1] = seq;
+    std::memcpy(raw + 2, &time, 4); // both targets are little endian
+    raw[6] = count;
+    std::memcpy(raw + telemetryHeaderSize, values, payload);
+    uint16_t crc = crc16Ccitt(raw, telemetryHeaderSize + payload);
+    std::memcpy(raw + telemetryHeaderSize + payload, &crc, 2);
+    return encodeWireFrame(raw, telemetryHeaderSize + payload + 2, out);
+}
+
+// decodes a frame without its delimiter. Returns false on a COBS, length, or CRC error
+inline bool decodeTelemetryFrame(const uint8_t* frame, size_t length, TelemetrySample& sample) {
+    uint8_t raw[telemetryMaxRawSize];
+    size_t rawLength = cobsDecode(frame, length, raw, sizeof(raw));
+    if (rawLength < telemetryHeaderSize + 2) return false;
+    const TelemetryChannelInfo* info = telemetryChannelInfo(raw[0]);
+    if (info == nullptr || raw[6] > telemetryMaxValues) return false;
+    size_t payload = raw[6] * telemetryTypeSize(info->type);
+    if (rawLength != telemetryHeaderSize + payload + 2) return false;
+    uint16_t crc;
+    std::memcpy(&crc, raw + telemetryHeaderSize + payload, 2);
+    if (crc != crc16Ccitt(raw, telemetryHeaderSize + payload)) return false;
+    sample.channel = info->channel;
+    sample.seq = raw[1];
+    std::memcpy(&sample.time, raw + 2, 4);
+    sample.count = raw[6];
+    std::memcpy(sample.values, raw + telemetryHeaderSize, payload);
+    return true;
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "main.h"
+#include "trace_ring.h"
+
+/*
+ * Timeline tracing in Chrome trace / Perfetto format.
+ *
+ * TRACE_SCOPE, TRACE_BEGIN/TRACE_END, TRACE_COUNTER and TRACE_INSTANT record into the calling
+ * task's own ring (trace_ring.h) and return; a low priority task turns the events into Chrome
+ * trace JSON and sends them to serial or the card. Pull the JSON out of a capture with
+ * tools/trace_extract and open it in ui.perfetto.dev or chrome://tracing.
+ *
+ * Names must be string literals. The macros compile out unless the build sets TRACE_ENABLED
+ * (`make TRACE=1`); that build also calls startTrace() in initialize(). Nothing is recorded
+ * before startTrace().
+ *
+ * <h3> Example Usage </h3>
+ * @code
+ * void odomTick() {
+ *     TRACE_SCOPE("odom tick");
+ *     ...
+ *     TRACE_COUNTER("odom x", pose.x);
+ * }
+ * @endcode
+ */
+
+#ifndef TRACE_ENABLED
+#define TRACE_ENABLED 0
+#endif
+
+enum class TraceOutput {
+    SERIAL, // a "T,{event}" line per event on stdout
+    SD // the same lines on the microSD card, see sd_logger.h
+};
+
+struct TraceStats {
+    uint32_t events = 0; // recorded
+    uint32_t dropped = 0; // rings were full, or more tasks traced than there are rings
+    uint32_t tasks = 0; // tasks that have traced
+};
+
+/**
+ * Starts recording and the exporter task (once). Events before this call are not kept
+ */
+void startTrace(TraceOutput output);
+
+/**
+ * Stops recording; what is already recorded is still exported
+ */
+void stopTrace();
+
+void traceEvent(TraceType type, const char* name, float value = 0);
+
+/**
+ * Adds LVGL's display refresh and render phases to the timeline, on LVGL's task
+ */
+void traceLvglRefresh();
+
+TraceStats getTraceStats();
+
+/**
+ * BEGIN now, END when it goes out of scope
+ */
+class TraceScope {
+    public:
+        explicit TraceScope(const char* name)
+            : name(name) {
+            traceEvent(TraceType::BEGIN, name);
+        }
+
+        ~TraceScope() { traceEvent(TraceType::END, name); }
+
+        TraceScope(const TraceScope&) = delete;
+        TraceScope& operator=(const TraceScope&) = delete;
+    private:
+        const char* name;
+};
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+
+#if TRACE_ENABLED
+#define TRACE_SCOPE(name) TraceScope TRACE_CONCAT(traceScope, __LINE__)(name)
+#define TRACE_BEGIN(name) traceEvent(TraceType::BEGIN, name)
+#define TRACE_END(name) traceEvent(TraceType::END, name)
+#define TRACE_COUNTER(name, value) traceEvent(TraceType::COUNTER, name, static_cast<float>(value))
+#define TRACE_INSTANT(name) traceEvent(TraceType::INSTANT, name)
+#else
+#define TRACE_SCOPE(name) ((void)0)
+#define TRACE_BEGIN(name) ((void)0)
+#define TRACE_END(name) ((void)0)
+#define TRACE_COUNTER(name, value) ((void)0)
+#define TRACE_INSTANT(name) ((void)0)
+#endif
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/*
+ * Trace events and the per-task rings they are recorded into. Each task that traces claims a
+ * ring of its own on its first event, so recording is a single producer push with no lock and no
+ * contention between tasks; one exporter task drains every ring. PROS-free so host tools can
+ * share the layout.
+ */
+
+enum class TraceType : uint8_t { BEGIN, END, COUNTER, INSTANT };
+
+struct TraceEvent {
+    const char* name; // must have static storage duration (string literal)
+    uint64_t time; // us
+    float value; // COUNTER only
+    TraceType type;
+};
+
+/**
+ * Bounded single-producer single-consumer queue. tryPush fails (and counts) when full
+ */
+template <size_t depth> class TraceRing {
+        static_assert((depth & (depth - 1)) == 0, "depth must be a power of two");
+    public:
+        bool tryPush(const TraceEvent& event) {
+            uint32_t position = tail.load(std::memory_order_relaxed);
+            if (position - head.load(std::memory_order_acquire) >= depth) {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            events[position & (depth - 1)] = event;
+            tail.store(position + 1, std::memory_order_release);
+            return true;
+        }
+
+        bool tryPop(TraceEvent& event) {
+            uint32_t position = head.load(std::memory_order_relaxed);
+            if (position == tail.load(std::memory_order_acquire)) return false;
+            event = events[position & (depth - 1)];
+            head.store(position + 1, std::memory_order_release);
+            return true;
+        }
+
+        /** events rejected because the ring was full */
+        uint32_t droppedCount() const { return dropped.load(std::memory_order_relaxed); }
+    private:
+        TraceEvent events[depth];
+        std::atomic<uint32_t> head = 0;
+        std::atomic<uint32_t> tail = 0;
+        std::atomic<uint32_t> dropped = 0;
+};
+
+/**
+ * A fixed set of rings, each claimed by an owner key (a task handle) and name the first time it
+ * traces. Rings are claimed in order, so the claimed ones are always 0..size()-1.
+ *
+ * The name is copied when the ring is claimed, since the task may be gone by the time it is
+ * exported. Rings are never released: a task that ends keeps its ring. A later task that gets
+ * the same handle shares that ring only if it also has the same name, as PROS's competition tasks
+ * do when it restarts them. Otherwise it claims a new ring.
+ */
+template <size_t maxRings, size_t depth> class TraceRings {
+    public:
+        static constexpr size_t nameLength = 16;
+
+        /**
+         * The ring owned by key and name, claiming a free one on first use. nullptr if all are taken
+         */
+        TraceRing<depth>* ring(uintptr_t key, const char* name) {
+            for (size_t i = 0; i < maxRings; i++) {
+                uintptr_t owner = owners[i].load(std::memory_order_acquire);
+                if (owner == key && ownedBy(i, name)) return &rings[i];
+                if (owner != 0) continue;
+                if (owners[i].compare_exchange_strong(owner, key, std::memory_order_acq_rel)) {
+                    strncpy(names[i], name != nullptr ? name : "", nameLength - 1);
+                    named[i].store(true, std::memory_order_release);
+                    return &rings[i];
+                }
+                if (owner == key && ownedBy(i, name)) return &rings[i];
+            }
+            return nullptr;
+        }
+
+        /** the name the ring was claimed with, nullptr until its owner has copied it */
+        const char* name(size_t index) const {
+            return named[index].load(std::memory_order_acquire) ? names[index] : nullptr;
+        }
+
+        size_t size() const {
+            size_t count = 0;
+            while (count < maxRings && owners[count].load(std::memory_order_acquire) != 0) count++;
+            return count;
+        }
+
+        TraceRing<depth>& at(size_t index) { return rings[index]; }
+    private:
+        // only a task with this ring's key can get here, and no other live task has it
+        bool ownedBy(size_t index, const char* name) const {
+            return named[index].load(std::memory_order_acquire) &&
+                   strncmp(names[index], name != nullptr ? name : "", nameLength - 1) == 0;
+        }
+
+        TraceRing<depth> rings[maxRings];
+        std::atomic<uintptr_t> owners[maxRings] = {};
+        char names[maxRings][nameLength] = {};
+        std::atomic<bool> named[maxRings] = {};
+};
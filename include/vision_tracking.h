@@ -0,0 +1,46 @@
+#pragma once
+
+#include "main.h"
+#include "object_tracker.h"
+
+/**
+ * Tracker class id for an AI model object. Colour-descriptor detections use their
+ * descriptor id (1-7) directly.
+ */
+constexpr uint8_t visionModelClass(uint8_t id) { return 0x80 | id; }
+
+struct VisionStats {
+    uint32_t frames = 0;
+    uint32_t overBudget = 0; // frames that took longer than the budget
+    uint32_t lastUs = 0;
+    uint32_t maxUs = 0;
+    uint8_t detectionCap = 0; // detections processed per frame right now
+};
+
+/**
+ * Starts tracking AI Vision sensor detections every periodMs milliseconds.
+ *
+ * If a frame takes longer than budgetUs, the next frames only take the largest detections
+ * until the tracker is back under budget.
+ */
+void startVisionTracking(uint8_t port, CameraModel camera = {}, uint32_t periodMs = 20, uint32_t budgetUs = 1000);
+
+/**
+ * Gets the field position of the nearest confirmed object of classId, for turnToPoint/moveToPoint.
+ * Returns false if there is no live track of that class.
+ *
+ * <h3> Example Usage </h3>
+ * @code
+ * float x, y;
+ * if (getVisionTarget(1, x, y)) chassis.moveToPoint(x, y, 1500);
+ * @endcode
+ */
+bool getVisionTarget(uint8_t classId, float& x, float& y);
+
+VisionStats getVisionStats();
+
+/**
+ * Prints every frame's detections to stdout as "V,time,robotX,robotY,robotTheta,class,x,y,w,h"
+ * lines for tools/tracker_replay, and "V,time,robotX,robotY,robotTheta" for a frame with none
+ */
+void setVisionRecording(bool enabled);
@@ -0,0 +1,194 @@
+#include "main.h"
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include "arena.h"
+#include "executor.h"
+#include "fast_log.h"
+#include "alloc_audit.h"
+
+static constexpr size_t maxTasks = 24;
+static constexpr size_t taskNameLength = 16;
+
+struct TaskAllocs {
+    std::atomic<uintptr_t> task = 0;
+    char name[taskNameLength] = {}; // copied when claimed, the task may be gone by the report
+    std::atomic<uint32_t> allocations = 0;
+    std::atomic<uint32_t> frees = 0;
+    std::atomic<uint32_t> bytes = 0;
+    std::atomic<uint32_t> violations = 0;
+    std::atomic<const char*> lastViolation = nullptr;
+    std::atomic<uint32_t> lastViolationBytes = 0;
+    const char* guard = nullptr; // the innermost open NoAllocScope, only its own task touches it
+    uint32_t reported = 0; // violations already logged, the audit job's own
+};
+
+// tasks claim a slot on their first allocation, like trace rings. Allocations before the scheduler
+// runs, and from tasks beyond the table, share the last two
+static TaskAllocs taskAllocs[maxTasks];
+static TaskAllocs startupAllocs;
+static TaskAllocs otherAllocs;
+static std::atomic<AllocPhase> currentPhase = AllocPhase::INITIALIZE;
+static std::atomic<uint32_t> phaseAllocations[allocPhaseCount] = {};
+static std::atomic<uint32_t> phaseFrees[allocPhaseCount] = {};
+static std::atomic<uint32_t> phaseBytes[allocPhaseCount] = {};
+static std::atomic<uint32_t> totalViolations = 0;
+static AllocAlarm alarmMode = AllocAlarm::LOG;
+
+// runs inside operator new: no allocation, no locks
+static TaskAllocs& currentTaskAllocs() {
+    uintptr_t task = reinterpret_cast<uintptr_t>(pros::c::task_get_current());
+    if (task == 0) return startupAllocs;
+    for (TaskAllocs& slot : taskAllocs) {
+        uintptr_t owner = slot.task.load(std::memory_order_acquire);
+        if (owner == task) return slot;
+        if (owner != 0) continue;
+        if (slot.task.compare_exchange_strong(owner, task, std::memory_order_acq_rel)) {
+            strncpy(slot.name, pros::c::task_get_name(nullptr), taskNameLength - 1);
+            return slot;
+        }
+        if (owner == task) return slot;
+    }
+    return otherAllocs;
+}
+
+static void recordAllocation(size_t size) {
+    size_t phase = static_cast<size_t>(currentPhase.load(std::memory_order_relaxed));
+    phaseAllocations[phase].fetch_add(1, std::memory_order_relaxed);
+    phaseBytes[phase].fetch_add(static_cast<uint32_t>(size), std::memory_order_relaxed);
+    TaskAllocs& slot = currentTaskAllocs();
+    slot.allocations.fetch_add(1, std::memory_order_relaxed);
+    slot.bytes.fetch_add(static_cast<uint32_t>(size), std::memory_order_relaxed);
+    if (slot.guard != nullptr) {
+        slot.lastViolation = slot.guard;
+        slot.lastViolationBytes = static_cast<uint32_t>(size);
+        slot.violations++;
+        totalViolations++;
+    }
+}
+
+static void recordFree(void* memory) {
+    if (memory == nullptr) return;
+    size_t phase = static_cast<size_t>(currentPhase.load(std::memory_order_relaxed));
+    phaseFrees[phase].fetch_add(1, std::memory_order_relaxed);
+    currentTaskAllocs().frees.fetch_add(1, std::memory_order_relaxed);
+}
+
+/* OPERATOR NEW */
+// replaces the library's, every new and delete in the program (lemlib and PROS included) comes here
+void* operator new(size_t size) {
+    void* memory = malloc(size != 0 ? size : 1);
+    if (memory == nullptr) throw std::bad_alloc();
+    recordAllocation(size);
+    return memory;
+}
+
+void* operator new[](size_t size) { return operator new(size); }
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    void* memory = malloc(size != 0 ? size : 1);
+    if (memory != nullptr) recordAllocation(size);
+    return memory;
+}
+
+void* operator new[](size_t size, const std::nothrow_t& tag) noexcept { return operator new(size, tag); }
+
+void operator delete(void* memory) noexcept {
+    recordFree(memory);
+    free(memory);
+}
+
+void operator delete[](void* memory) noexcept { operator delete(memory); }
+
+void operator delete(void* memory, size_t) noexcept { operator delete(memory); }
+
+void operator delete[](void* memory, size_t) noexcept { operator delete(memory); }
+
+/* PHASES AND SCOPES */
+void setAllocPhase(AllocPhase phase) { currentPhase = phase; }
+
+NoAllocScope::NoAllocScope(const char* what) {
+    TaskAllocs& slot = currentTaskAllocs();
+    previous = slot.guard;
+    slot.guard = what;
+}
+
+NoAllocScope::~NoAllocScope() { currentTaskAllocs().guard = previous; }
+
+/* REPORTING */
+static void reportViolations(TaskAllocs& slot, pros::Controller& master) {
+    uint32_t violations = slot.violations;
+    if (violations == slot.reported) return;
+    fastLogger().error("heap allocation in {} on task {}: {} bytes, {} in steady state so far",
+                       LogLiteral::fromStatic(slot.lastViolation.load()),
+                       LogLiteral::fromStatic(slot.name[0] != 0 ? slot.name : "?"), slot.lastViolationBytes.load(),
+                       violations);
+    if (alarmMode == AllocAlarm::LOUD) master.rumble("-");
+    slot.reported = violations;
+}
+
+static void checkViolations() {
+    static pros::Controller master(pros::E_CONTROLLER_MASTER);
+    static uint32_t seen = 0;
+    uint32_t violations = totalViolations;
+    if (violations == seen) return;
+    seen = violations;
+    for (TaskAllocs& slot : taskAllocs) reportViolations(slot, master);
+    reportViolations(otherAllocs, master);
+}
+
+void startAllocAudit(AllocAlarm alarm, uint32_t periodMs) {
+    alarmMode = alarm;
+    addPeriodicJob("alloc audit", periodMs, 500, checkViolations);
+}
+
+AllocStats getAllocStats() {
+    AllocStats stats;
+    for (size_t i = 0; i < allocPhaseCount; i++) {
+        stats.phases[i].allocations = phaseAllocations[i];
+        stats.phases[i].frees = phaseFrees[i];
+        stats.phases[i].bytes = phaseBytes[i];
+        stats.total.allocations += stats.phases[i].allocations;
+        stats.total.frees += stats.phases[i].frees;
+        stats.total.bytes += stats.phases[i].bytes;
+    }
+    stats.violations = totalViolations;
+    for (const TaskAllocs& slot : taskAllocs) {
+        if (slot.task != 0) stats.tasks++;
+    }
+    return stats;
+}
+
+static void printTaskAllocs(const char* name, const TaskAllocs& slot) {
+    if (slot.allocations == 0) return;
+    printf("  %-16s %8lu allocs %8lu frees %9lu bytes %6lu violations", name,
+           static_cast<unsigned long>(slot.allocations.load()), static_cast<unsigned long>(slot.frees.load()),
+           static_cast<unsigned long>(slot.bytes.load()), static_cast<unsigned long>(slot.violations.load()));
+    if (slot.violations != 0) printf(" (last in %s)", slot.lastViolation.load());
+    printf("\n");
+}
+
+void printAllocReport() {
+    static constexpr const char* phaseNames[allocPhaseCount] = {"initialize", "autonomous", "opcontrol", "disabled"};
+    AllocStats stats = getAllocStats();
+    printf("heap: %lu allocations, %lu frees, %lu bytes asked for, %lu steady-state violations\n",
+           static_cast<unsigned long>(stats.total.allocations), static_cast<unsigned long>(stats.total.frees),
+           static_cast<unsigned long>(stats.total.bytes), static_cast<unsigned long>(stats.violations));
+    for (size_t i = 0; i < allocPhaseCount; i++) {
+        printf("  %-16s %8lu allocs %8lu frees %9lu bytes\n", phaseNames[i],
+               static_cast<unsigned long>(stats.phases[i].allocations),
+               static_cast<unsigned long>(stats.phases[i].frees), static_cast<unsigned long>(stats.phases[i].bytes));
+    }
+    printTaskAllocs("(startup)", startupAllocs);
+    for (const TaskAllocs& slot : taskAllocs) {
+        if (slot.task != 0) printTaskAllocs(slot.name, slot);
+    }
+    printTaskAllocs("(other tasks)", otherAllocs);
+    for (size_t i = 0; i < Arena::count(); i++) {
+        const Arena& arena = Arena::at(i);
+        printf("arena %-10s %6lu of %6lu bytes, %lu requests did not fit (%lu bytes)\n", arena.name,
+               static_cast<unsigned long>(arena.used()), static_cast<unsigned long>(arena.capacity()),
+               static_cast<unsigned long>(arena.failureCount()), static_cast<unsigned long>(arena.failureBytes()));
+    }
+}
@@ -1,30 +1,25 @@
 #include "main.h"
 #include "auton.h"
-#include "helpers.h"
+#include "auton_actions.h"
+#include "trace.h"
 #include "lemlib/api.hpp"
 
-void scoreBlocks() {
-  setSpeedIntakeTop(-115);
-  pros::delay(3000);
-  setSpeedIntakeTop(0);
-}
-
-void autonRouteOne() {
-  chassis.moveToPoint(0, 24.14, 1000, {.maxSpeed=80});
-  chassis.turnToHeading(90, 500);
-  chassis.moveToPoint(28, 24.14, 1000, {.maxSpeed=80});
-  chassis.moveToPoint(24, 24.14, 500, {.forwards=false});
-  chassis.turnToHeading(0, 500);
-  chassis.moveToPoint(24, 84.14, 1500, {.forwards=true, .maxSpeed=115});
-  chassis.turnToHeading(90, 500);
-  chassis.moveToPoint(48, 84.14, 1000, {.maxSpeed=80});
+static constexpr AutonStep routeOne[] = {
+  moveTo(0, 24.14, 1000, {.maxSpeed=80}),
+  turnTo(90, 500),
+  moveTo(28, 24.14, 1000, {.maxSpeed=80}),
+  moveTo(24, 24.14, 500, {.forwards=false}),
+  turnTo(0, 500),
+  moveTo(24, 84.14, 1500, {.forwards=true, .maxSpeed=115}),
+  turnTo(90, 500),
+  moveTo(48, 84.14, 1000, {.maxSpeed=80}),
 
   // scoring
-  chassis.turnToHeading(0, 500);
-  chassis.moveToPoint(48, 79.14, 1000, {.forwards=false, .maxSpeed=50});
-  scoreBlocks();
+  turnTo(0, 500),
+  moveTo(48, 79.14, 1000, {.forwards=false, .maxSpeed=50}),
+  score(),
+};
 
-  
   /*
   chassis.moveToPose(0, 24.14, 90, 1000, {.maxSpeed=80}); // (24-16.86) + 24 - 7 for y coord (of center) (now that we know the center, we can do other calculations "normally")
   pros::delay(200);
@@ -44,23 +39,23 @@ void autonRouteOne() {
   pros::delay(200);
   scoreBlocks();
   */
-}
 
-void autonRouteTwo() {
+static constexpr AutonStep routeTwo[] = {
   // return to new start
-  chassis.moveToPoint(48, 84.14, 1000, {.forwards=true, .maxSpeed=50});
-  chassis.turnToHeading(270, 500);
-  chassis.moveToPoint(-48, 84.14, 2000, {.maxSpeed=115});
-  chassis.turnToHeading(180, 500);
-  chassis.moveToPoint(-48, 12.14, 2000, {.maxSpeed=115});
-  chassis.turnToHeading(270, 500);
-  chassis.moveToPoint(-72, 12.14, 1000, {.maxSpeed=80});
+  moveTo(48, 84.14, 1000, {.forwards=true, .maxSpeed=50}),
+  turnTo(270, 500),
+  moveTo(-48, 84.14, 2000, {.maxSpeed=115}),
+  turnTo(180, 500),
+  moveTo(-48, 12.14, 2000, {.maxSpeed=115}),
+  turnTo(270, 500),
+  moveTo(-72, 12.14, 1000, {.maxSpeed=80}),
 
   //scoring
-  chassis.turnToHeading(180, 500);
-  chassis.moveToPoint(-72, 17.14, 1000, {.forwards=false, .maxSpeed=50});
-  scoreBlocks();
-  
+  turnTo(180, 500),
+  moveTo(-72, 17.14, 1000, {.forwards=false, .maxSpeed=50}),
+  score(),
+};
+
   /*
   // return to new starting point
   chassis.moveToPose(45, 86.14, 270, 500, {.forwards=true, .maxSpeed=50});
@@ -89,16 +84,16 @@ void autonRouteTwo() {
   pros::delay(200);
   scoreBlocks();
   */
-}
 
-void autonRouteThree() {
+static constexpr AutonStep routeThree[] = {
   // going back to park
-  chassis.moveToPoint(-72, 12.14, 1000, {.fowards=true, .maxSpeed=50});
-  chassis.turnToHeading(90, 500);
-  chassis.moveToPoint(0, 12.14, 1000, {.maxSpeed=80});
-  chassis.turnToHeading(180, 500);
-  chassis.moveToPoint(0, -15, 1000, {.maxSpeed=80});
-  
+  moveTo(-72, 12.14, 1000, {.forwards=true, .maxSpeed=50}),
+  turnTo(90, 500),
+  moveTo(0, 12.14, 1000, {.maxSpeed=80}),
+  turnTo(180, 500),
+  moveTo(0, -15, 1000, {.maxSpeed=80}),
+};
+
   /*
   pros::delay(200);
   chassis.moveToPose(0, 21.86, 180, 1500, {.maxSpeed=115});
@@ -106,4 +101,50 @@ void autonRouteThree() {
   chassis.moveToPose(0, -9.86, 180, 1000, {.forwards=false, .maxSpeed=70});
   pros::delay(200);
   */
+
+const AutonRoute autonRoutes[3] = {
+  {routeOne, sizeof(routeOne) / sizeof(routeOne[0])},
+  {routeTwo, sizeof(routeTwo) / sizeof(routeTwo[0])},
+  {routeThree, sizeof(routeThree) / sizeof(routeThree[0])},
+};
+
+Action routeAction(const AutonRoute& route) {
+  for (size_t i = 0; i < route.count; i++) {
+    const AutonStep& step = route.steps[i];
+    TRACE_COUNTER("auton step", i);
+    // the span is the whole step, from starting it until the robot is done with it
+    TRACE_SCOPE("auton step");
+    bool ok = false;
+    bool scoreAlong = i + 1 < route.count && route.steps[i + 1].action == AutonAction::SCORE;
+    switch (step.action) {
+      case AutonAction::MOVE:
+        if (scoreAlong) {
+          // scoring starts with the move into the goal, as it did when moves were fire and forget
+          ok = co_await whenAll(auton::moveToPoint(step.x, step.y, step.timeout, step.params), auton::score());
+          i++;
+        } else {
+          ok = co_await auton::moveToPoint(step.x, step.y, step.timeout, step.params);
+        }
+        break;
+      case AutonAction::TURN: ok = co_await auton::turnToHeading(step.x, step.timeout); break;
+      case AutonAction::SCORE: ok = co_await auton::score(); break;
+    }
+    // only cancellation fails a step, lemlib's own timeouts just end the motion
+    if (!ok) co_return false;
+  }
+  co_return true;
+}
+
+Action matchAuton() {
+  // route one (collecting blocks and scoring)
+  bool ok = co_await routeAction(autonRoutes[0]);
+  if (!ok) co_return false;
+  co_await sleepFor(200);
+  // route two (go to new start point, collect blocks and score)
+  ok = co_await routeAction(autonRoutes[1]);
+  if (!ok) co_return false;
+  co_await sleepFor(200);
+  // route three (parking)
+  ok = co_await routeAction(autonRoutes[2]);
+  co_return ok;
 }
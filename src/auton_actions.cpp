@@ -0,0 +1,107 @@
+#include "main.h"
+#include <cmath>
+#include "lemlib/api.hpp"
+#include "global.h"
+#include "trace.h"
+#include "fast_log.h"
+#include "field_layout.h"
+#include "pose_feed.h"
+#include "auton_actions.h"
+
+static bool chassisIdle() { return !chassis.isInMotion(); }
+
+bool auton::run(Action (*makeAction)(), uint32_t periodMs) {
+    uint32_t lastWake = pros::millis();
+    return runAction(makeAction, lastWake, [&] {
+        pros::Task::delay_until(&lastWake, periodMs);
+        TRACE_BEGIN("auton tick");
+        coroScheduler().tick(pros::millis());
+        TRACE_END("auton tick");
+    });
+}
+
+Action auton::moveToPoint(float x, float y, int timeout, lemlib::MoveToPointParams params) {
+    bool idle = co_await waitUntil(chassisIdle);
+    if (!idle) co_return false;
+    chassis.moveToPoint(x, y, timeout, params, true);
+    bool ok = co_await waitUntil(chassisIdle);
+    if (!ok) chassis.cancelMotion();
+    co_return ok;
+}
+
+Action auton::turnToHeading(float heading, int timeout) {
+    bool idle = co_await waitUntil(chassisIdle);
+    if (!idle) co_return false;
+    chassis.turnToHeading(heading, timeout, {}, true);
+    bool ok = co_await waitUntil(chassisIdle);
+    if (!ok) chassis.cancelMotion();
+    co_return ok;
+}
+
+Action auton::score() {
+    intakeTop.move(-115);
+    bool ok = co_await sleepFor(3000);
+    intakeTop.move(0);
+    co_return ok;
+}
+
+/* PLANNED ROUTES */
+static constexpr size_t maxLegs = 16;
+static constexpr float legTolerance = 6; // inches short of a leg's end that counts as blocked
+static constexpr int maxReplans = 2;
+
+// about 100 KB of grid, too much for a task stack
+static PathPlanner& planner() {
+    static PathPlanner* field = [] {
+        static PathPlanner instance;
+        instance.setField(fieldObstacles, fieldObstacleCount);
+        return &instance;
+    }();
+    return *field;
+}
+
+bool auton::blockFieldArea(FieldRect area) {
+    return planner().block({area.x0 + odomOriginX, area.y0 + odomOriginY, area.x1 + odomOriginX, area.y1 + odomOriginY});
+}
+
+// plans from the current pose, legs in odometry coordinates
+static size_t planFromPose(PlanPoint goal, PlanPoint* legs) {
+    TRACE_SCOPE("route plan");
+    PoseSnapshot pose = latestPose();
+    uint64_t start = pros::micros();
+    size_t count = planner().plan({pose.x + odomOriginX, pose.y + odomOriginY},
+                                  {goal.x + odomOriginX, goal.y + odomOriginY}, robotRadiusInches, legs, maxLegs);
+    const PlanStats& stats = planner().lastStats();
+    fastLogger().info("route to ({}, {}): {} legs, {} in, {} cells in {} us", goal.x, goal.y, count, stats.length,
+                      stats.expanded, static_cast<uint32_t>(pros::micros() - start));
+    for (size_t i = 0; i < count; i++) legs[i] = {legs[i].x - odomOriginX, legs[i].y - odomOriginY};
+    return count;
+}
+
+Action auton::driveTo(float x, float y, float maxSpeed) {
+    PlanPoint legs[maxLegs];
+    for (int replans = 0; replans <= maxReplans; replans++) {
+        size_t count = planFromPose({x, y}, legs);
+        if (count == 0) co_return false;
+        bool blocked = false;
+        for (size_t i = 0; i < count && !blocked; i++) {
+            PoseSnapshot pose = latestPose();
+            float length = std::hypot(legs[i].x - pose.x, legs[i].y - pose.y);
+            bool moved = co_await auton::moveToPoint(legs[i].x, legs[i].y, legTimeoutMs(length), {.maxSpeed = maxSpeed});
+            if (!moved) co_return false;
+            pose = latestPose();
+            float dx = legs[i].x - pose.x;
+            float dy = legs[i].y - pose.y;
+            float shortBy = std::hypot(dx, dy);
+            if (shortBy <= legTolerance) continue;
+            // something is in the way: block a robot-sized square just ahead and go around it
+            float aheadX = pose.x + dx / shortBy * robotRadiusInches * 2;
+            float aheadY = pose.y + dy / shortBy * robotRadiusInches * 2;
+            blockFieldArea({aheadX - robotRadiusInches, aheadY - robotRadiusInches, aheadX + robotRadiusInches,
+                            aheadY + robotRadiusInches});
+            blocked = true;
+        }
+        if (!blocked) co_return true;
+    }
+    co_return false;
+}
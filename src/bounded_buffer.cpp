@@ -0,0 +1,136 @@
+#include "main.h"
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include "arena.h"
+#include "bounded_buffer.h"
+
+// records are stored as [length u16][bytes], wrapping around the end of the ring
+static constexpr size_t recordHeader = 2;
+
+// stdout's and telemetry's rings and batches, with room for one more small buffer
+static StaticArena<16 * 1024> bufferArena("buffers");
+
+static uint8_t* takeBytes(size_t size) {
+    void* bytes = bufferArena.allocate(size, 1);
+    // over budget: still works, and the arena's failure count shows up in printAllocReport()
+    return bytes != nullptr ? static_cast<uint8_t*>(bytes) : new uint8_t[size];
+}
+
+BoundedBuffer::BoundedBuffer(size_t capacity, OverflowPolicy policy, WriteFn write, void* context, size_t batchSize)
+    : storage(takeBytes(capacity)),
+      batch(takeBytes(batchSize)),
+      capacity(capacity),
+      batchSize(batchSize),
+      policy(policy),
+      writeFn(write),
+      context(context),
+      task([this] { taskLoop(); }, TASK_PRIORITY_MIN + 1, TASK_STACK_DEPTH_DEFAULT, "Bounded Buffer") {}
+
+BoundedBuffer::~BoundedBuffer() {
+    task.remove();
+    if (!bufferArena.owns(storage)) delete[] storage;
+    if (!bufferArena.owns(batch)) delete[] batch;
+}
+
+void BoundedBuffer::read(size_t position, uint8_t* out, size_t length) const {
+    position %= capacity;
+    size_t first = std::min(length, capacity - position);
+    std::memcpy(out, storage + position, first);
+    std::memcpy(out + first, storage, length - first);
+}
+
+void BoundedBuffer::write(size_t position, const uint8_t* data, size_t length) {
+    position %= capacity;
+    size_t first = std::min(length, capacity - position);
+    std::memcpy(storage + position, data, first);
+    std::memcpy(storage, data + first, length - first);
+}
+
+bool BoundedBuffer::push(const void* data, size_t length) {
+    size_t needed = length + recordHeader;
+    std::lock_guard<pros::Mutex> lock(mutex);
+    // a record that can never be flushed in one batch is dropped up front
+    if (needed > capacity || needed > batchSize) {
+        stats.dropped++;
+        return false;
+    }
+    if (capacity - used < needed) {
+        if (policy == OverflowPolicy::DROP_NEWEST) {
+            stats.dropped++;
+            return false;
+        }
+        while (capacity - used < needed) {
+            uint16_t oldest;
+            read(head, reinterpret_cast<uint8_t*>(&oldest), recordHeader);
+            head = (head + recordHeader + oldest) % capacity;
+            used -= recordHeader + oldest;
+            queuedRecords--;
+            stats.dropped++;
+        }
+    }
+    uint16_t header = static_cast<uint16_t>(length);
+    write(head + used, reinterpret_cast<const uint8_t*>(&header), recordHeader);
+    write(head + used + recordHeader, static_cast<const uint8_t*>(data), length);
+    used += needed;
+    queuedRecords++;
+    stats.enqueued++;
+    stats.highWaterBytes = std::max<uint32_t>(stats.highWaterBytes, used);
+    return true;
+}
+
+size_t BoundedBuffer::takeBatch(uint32_t& records) {
+    std::lock_guard<pros::Mutex> lock(mutex);
+    size_t length = 0;
+    records = 0;
+    while (queuedRecords > 0) {
+        uint16_t size;
+        read(head, reinterpret_cast<uint8_t*>(&size), recordHeader);
+        if (length + size > batchSize) break;
+        read(head + recordHeader, batch + length, size);
+        length += size;
+        head = (head + recordHeader + size) % capacity;
+        used -= recordHeader + size;
+        queuedRecords--;
+        records++;
+    }
+    return length;
+}
+
+void BoundedBuffer::flush() {
+    std::lock_guard<pros::Mutex> flushLock(flushMutex);
+    uint32_t records;
+    size_t length;
+    while ((length = takeBatch(records)) > 0) {
+        writeFn(batch, length, context);
+        std::lock_guard<pros::Mutex> lock(mutex);
+        stats.flushed += records;
+        stats.flushes++;
+    }
+}
+
+BufferStats BoundedBuffer::getStats() {
+    std::lock_guard<pros::Mutex> lock(mutex);
+    BufferStats snapshot = stats;
+    snapshot.queuedBytes = used;
+    return snapshot;
+}
+
+void BoundedBuffer::taskLoop() {
+    uint32_t lastWake = pros::millis();
+    while (true) {
+        flush();
+        pros::Task::delay_until(&lastWake, rate);
+    }
+}
+
+/* STDOUT */
+static void writeStdout(const uint8_t* data, size_t length, void*) {
+    fwrite(data, 1, length, stdout);
+    fflush(stdout);
+}
+
+BoundedBuffer& boundedStdout() {
+    static BoundedBuffer buffer(8192, OverflowPolicy::DROP_NEWEST, writeStdout);
+    return buffer;
+}
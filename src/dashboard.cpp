@@ -0,0 +1,267 @@
+#include "main.h"
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include "liblvgl/lvgl.h"
+#include "format_types.h"
+#include "field_map.h"
+#include "numeric_label.h"
+#include "signals.h"
+#include "trace.h"
+#include "dashboard.h"
+
+/* LAYOUT */
+struct DashboardTile {
+    const char* signal; // name in src/signals.cpp
+    const char* title;
+    float threshold; // smallest change worth redrawing
+    int decimals;
+};
+
+static constexpr DashboardTile tiles[] = {
+    {"pose_x", "X (in)", 0.1f, 1},
+    {"pose_y", "Y (in)", 0.1f, 1},
+    {"pose_theta", "Theta (deg)", 0.5f, 1},
+    {"imu_heading_avg", "IMU avg (deg)", 0.5f, 1},
+    {"rotation_pos", "Tracking (cdeg)", 50, 0},
+    {"drive_temp_max", "Drive max (C)", 1, 0},
+    {"intake_top_temp", "Intake top (C)", 1, 0},
+    {"intake_bottom_temp", "Intake bot (C)", 1, 0},
+};
+static constexpr size_t tileCount = sizeof(tiles) / sizeof(tiles[0]);
+
+// pid errors on the chart, scaled to ints for lv_chart
+static constexpr const char* chartSignals[] = {"lateral_pid_error", "angular_pid_error"};
+static constexpr float chartScale = 10;
+static constexpr int32_t chartRange[] = {240, 900}; // +-24 in, +-90 deg
+static constexpr uint32_t chartPoints = 60;
+
+// the left half holds the values, the field map (field_map.h) the right half
+static constexpr int32_t panelWidth = 240;
+static constexpr int32_t tileWidth = 120;
+static constexpr int32_t tileHeight = 40;
+static constexpr int32_t chartTop = 4 * tileHeight;
+static constexpr int32_t chartHeight = 48;
+static constexpr int32_t imuTop = chartTop + chartHeight;
+static constexpr int32_t statusTop = imuTop + 14;
+
+// characters in a value field, right aligned
+static constexpr size_t valueChars = 9;
+
+// the robot on the map
+static constexpr const char* poseSignals[] = {"pose_x", "pose_y", "pose_theta"};
+
+// each IMU's heading and mounting, the readouts the llemu screen had
+static constexpr const char* imuSignals[] = {"imu1_heading", "imu1_orientation", "imu2_heading", "imu2_orientation"};
+
+// the status line is for people, once a second is plenty
+static constexpr uint32_t statusEvery = 10;
+
+/* STATE */
+struct TileState {
+    NumericLabel* value = nullptr;
+    SignalId signal = 0;
+    bool found = false;
+    bool shown = false;
+    float shownValue = 0;
+};
+
+static GlyphAtlas* valueAtlas = nullptr;
+static TileState tileStates[tileCount];
+static lv_obj_t* chart = nullptr;
+static lv_chart_series_t* chartSeries[2] = {};
+static SignalId chartIds[2] = {};
+static bool chartFound[2] = {};
+static SignalId poseIds[3] = {};
+static bool poseFound = true;
+static SignalId imuIds[4] = {};
+static bool imuFound = true;
+static lv_obj_t* imuLabel = nullptr;
+static char imuText[64] = "";
+static lv_obj_t* statusLabel = nullptr;
+static char statusText[64] = "";
+static uint32_t refreshCount = 0;
+
+static std::atomic<uint32_t> updateMicros = 0;
+static std::atomic<uint32_t> updateMicrosMax = 0;
+static std::atomic<uint32_t> renderMicros = 0;
+static std::atomic<uint32_t> renderMicrosMax = 0;
+static std::atomic<uint32_t> invalidatedPixels = 0;
+static std::atomic<uint32_t> labelsChanged = 0;
+static std::atomic<uint32_t> refreshes = 0;
+
+// written from LVGL's task through the display events
+static uint64_t renderStart = 0;
+static uint32_t pendingPixels = 0;
+
+static bool findSignal(const char* name, SignalId& id) {
+    const SignalTable<>& table = signalTable();
+    for (size_t i = 0; i < table.size(); i++) {
+        if (std::strcmp(table.info(static_cast<SignalId>(i)).name, name) == 0) {
+            id = static_cast<SignalId>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+static void onDisplayEvent(lv_event_t* e) {
+    switch (lv_event_get_code(e)) {
+        case LV_EVENT_INVALIDATE_AREA:
+            pendingPixels += lv_area_get_size(static_cast<lv_area_t*>(lv_event_get_param(e)));
+            break;
+        case LV_EVENT_REFR_START: renderStart = pros::micros(); break;
+        case LV_EVENT_REFR_READY: {
+            uint32_t elapsed = static_cast<uint32_t>(pros::micros() - renderStart);
+            renderMicros = elapsed;
+            if (elapsed > renderMicrosMax) renderMicrosMax = elapsed;
+            invalidatedPixels = pendingPixels;
+            pendingPixels = 0;
+            break;
+        }
+        default: break;
+    }
+}
+
+static lv_obj_t* createLabel(lv_obj_t* parent, const lv_font_t* font, int32_t x, int32_t y, int32_t width,
+                             int32_t height) {
+    lv_obj_t* label = lv_label_create(parent);
+    // fixed size and clipped, so a longer value never changes the layout or the redrawn area
+    lv_label_set_long_mode(label, LV_LABEL_LONG_CLIP);
+    lv_obj_set_pos(label, x, y);
+    lv_obj_set_size(label, width, height);
+    lv_obj_set_style_text_font(label, font, 0);
+    lv_obj_set_style_text_color(label, lv_color_white(), 0);
+    return label;
+}
+
+static void buildScreen() {
+    lv_obj_t* screen = lv_obj_create(nullptr);
+    lv_obj_set_style_bg_color(screen, lv_color_black(), 0);
+    lv_obj_remove_flag(screen, LV_OBJ_FLAG_SCROLLABLE);
+
+    // digits for every value tile are rendered once here, see numeric_label.h
+    valueAtlas = new GlyphAtlas(&lv_font_montserrat_18, lv_color_white(), lv_color_black());
+    for (size_t i = 0; i < tileCount; i++) {
+        int32_t x = static_cast<int32_t>(i % 2) * tileWidth + 4;
+        int32_t y = static_cast<int32_t>(i / 2) * tileHeight;
+        lv_obj_t* title = createLabel(screen, &lv_font_montserrat_10, x, y + 1, tileWidth - 8, 14);
+        lv_label_set_text_static(title, tiles[i].title);
+        lv_obj_set_style_text_color(title, lv_palette_main(LV_PALETTE_GREY), 0);
+        tileStates[i].value = new NumericLabel(screen, *valueAtlas, valueChars);
+        lv_obj_set_pos(tileStates[i].value->obj(), x, y + 15);
+        tileStates[i].found = findSignal(tiles[i].signal, tileStates[i].signal);
+        tileStates[i].value->setText(tileStates[i].found ? "--" : "n/a");
+    }
+
+    chart = lv_chart_create(screen);
+    lv_obj_set_pos(chart, 0, chartTop);
+    lv_obj_set_size(chart, panelWidth, chartHeight);
+    lv_chart_set_type(chart, LV_CHART_TYPE_LINE);
+    // circular mode only redraws the columns around the new point, shift mode redraws the chart
+    lv_chart_set_update_mode(chart, LV_CHART_UPDATE_MODE_CIRCULAR);
+    lv_chart_set_point_count(chart, chartPoints);
+    lv_chart_set_div_line_count(chart, 3, 0);
+    lv_obj_set_style_size(chart, 0, 0, LV_PART_INDICATOR); // no point markers
+    lv_chart_set_range(chart, LV_CHART_AXIS_PRIMARY_Y, -chartRange[0], chartRange[0]);
+    lv_chart_set_range(chart, LV_CHART_AXIS_SECONDARY_Y, -chartRange[1], chartRange[1]);
+    chartSeries[0] = lv_chart_add_series(chart, lv_palette_main(LV_PALETTE_BLUE), LV_CHART_AXIS_PRIMARY_Y);
+    chartSeries[1] = lv_chart_add_series(chart, lv_palette_main(LV_PALETTE_ORANGE), LV_CHART_AXIS_SECONDARY_Y);
+    for (size_t i = 0; i < 2; i++) chartFound[i] = findSignal(chartSignals[i], chartIds[i]);
+
+    imuLabel = createLabel(screen, &lv_font_montserrat_10, 4, imuTop + 2, panelWidth - 8, 14);
+    lv_label_set_text_static(imuLabel, "");
+    for (size_t i = 0; i < 4; i++) imuFound = findSignal(imuSignals[i], imuIds[i]) && imuFound;
+
+    statusLabel = createLabel(screen, &lv_font_montserrat_10, 4, statusTop + 2, panelWidth - 8, 14);
+    lv_label_set_text_static(statusLabel, "");
+
+    createFieldMap(screen, panelWidth, 0);
+    for (size_t i = 0; i < 3; i++) poseFound = findSignal(poseSignals[i], poseIds[i]) && poseFound;
+
+    lv_display_add_event_cb(lv_display_get_default(), onDisplayEvent, LV_EVENT_ALL, nullptr);
+    lv_screen_load(screen);
+}
+
+/* REFRESH */
+static uint32_t updateTiles(const float* values) {
+    uint32_t changed = 0;
+    for (size_t i = 0; i < tileCount; i++) {
+        TileState& state = tileStates[i];
+        if (!state.found) continue;
+        float value = values[state.signal];
+        if (state.shown && std::fabs(value - state.shownValue) < tiles[i].threshold) continue;
+        state.shown = true;
+        state.shownValue = value;
+        // only the digits that differ are copied and redrawn, a rounding to the same text is none
+        if (state.value->setValue(value, tiles[i].decimals) > 0) changed++;
+    }
+    return changed;
+}
+
+static void updateChart(const float* values) {
+    for (size_t i = 0; i < 2; i++) {
+        if (!chartFound[i]) continue;
+        float scaled = std::fmax(std::fmin(values[chartIds[i]] * chartScale, chartRange[i]), -chartRange[i]);
+        lv_chart_set_next_value(chart, chartSeries[i], static_cast<int32_t>(scaled));
+    }
+}
+
+// whole label, but only when the text changes, which at one decimal is a tenth of a degree
+static bool updateImus(const float* values) {
+    char text[sizeof(imuText)];
+    formatInto(text, "IMU1 {:.1f} deg o{:.0f}   IMU2 {:.1f} deg o{:.0f}", values[imuIds[0]], values[imuIds[1]],
+               values[imuIds[2]], values[imuIds[3]]);
+    if (std::strcmp(text, imuText) == 0) return false;
+    std::memcpy(imuText, text, sizeof(text));
+    lv_label_set_text_static(imuLabel, imuText);
+    return true;
+}
+
+static void updateStatus() {
+    char text[sizeof(statusText)];
+    formatInto(text, "upd {}/{} us  draw {}/{} us  {} px", updateMicros.load(),
+               updateMicrosMax.load(), renderMicros.load(), renderMicrosMax.load(), invalidatedPixels.load());
+    if (std::strcmp(text, statusText) == 0) return;
+    std::memcpy(statusText, text, sizeof(text));
+    lv_label_set_text_static(statusLabel, statusText);
+}
+
+// an lv_timer callback, so it runs on LVGL's task between renders
+static void refresh(lv_timer_t*) {
+    if (statusLabel == nullptr) buildScreen();
+    float values[SignalTable<>::capacity];
+    uint32_t timeMs;
+    if (!signalTable().latest(timeMs, values)) return;
+    TRACE_SCOPE("dashboard refresh");
+    uint64_t start = pros::micros();
+    uint32_t changed = updateTiles(values);
+    updateChart(values);
+    if (poseFound) updateFieldMap(values[poseIds[0]], values[poseIds[1]], values[poseIds[2]]);
+    if (imuFound && updateImus(values)) changed++;
+    if (refreshCount % statusEvery == 0) updateStatus();
+    uint32_t elapsed = static_cast<uint32_t>(pros::micros() - start);
+    updateMicros = elapsed;
+    if (elapsed > updateMicrosMax) updateMicrosMax = elapsed;
+    labelsChanged = changed;
+    refreshes = ++refreshCount;
+}
+
+void startDashboard(uint32_t periodMs) {
+    // lv_conf.h leaves LV_USE_OS at LV_OS_NONE, so lv_lock() does nothing and LVGL objects must
+    // only be touched from LVGL's own task. Creating the timer is the one call made from here;
+    // the screen is built by its first run
+    lv_timer_create(refresh, periodMs, nullptr);
+}
+
+DashboardStats getDashboardStats() {
+    DashboardStats stats;
+    stats.updateMicros = updateMicros;
+    stats.updateMicrosMax = updateMicrosMax;
+    stats.renderMicros = renderMicros;
+    stats.renderMicrosMax = renderMicrosMax;
+    stats.invalidatedPixels = invalidatedPixels;
+    stats.labelsChanged = labelsChanged;
+    stats.refreshes = refreshes;
+    return stats;
+}
@@ -0,0 +1,165 @@
+#include "main.h"
+#include <atomic>
+#include "trace.h"
+#include "alloc_audit.h"
+#include "executor.h"
+
+static constexpr size_t maxJobs = 16;
+
+struct Job {
+    const char* name = nullptr;
+    uint32_t periodMs = 0;
+    uint32_t budgetUs = 0;
+    void (*run)() = nullptr;
+    // the executor's own, nothing else reads these
+    uint32_t nextRelease = 0;
+    uint32_t lastRelease = 0;
+    uint64_t lastStart = 0;
+    uint64_t totalUs = 0;
+    // read by other tasks, each field on its own, see getJobStats()
+    std::atomic<uint32_t> runs = 0;
+    std::atomic<uint32_t> lastUs = 0;
+    std::atomic<uint32_t> maxUs = 0;
+    std::atomic<uint32_t> avgUs = 0;
+    std::atomic<uint32_t> jitterUs = 0;
+    std::atomic<uint32_t> jitterUsMax = 0;
+    std::atomic<uint32_t> overBudget = 0;
+    std::atomic<uint32_t> deadlineMisses = 0;
+    std::atomic<uint32_t> skipped = 0;
+};
+
+static Job jobs[maxJobs];
+static std::atomic<size_t> jobCount = 0;
+static pros::Mutex addMutex;
+
+// millisecond times wrap, compare them by difference
+static bool reached(uint32_t now, uint32_t time) { return static_cast<int32_t>(now - time) >= 0; }
+
+static void runJob(Job& job) {
+    uint32_t release = job.nextRelease;
+    uint64_t start = pros::micros();
+    TRACE_BEGIN(job.name);
+    if (job.runs == 0) {
+        job.run(); // first runs set up their statics
+    } else {
+        NoAllocScope noAlloc(job.name);
+        job.run();
+    }
+    TRACE_END(job.name);
+    uint64_t end = pros::micros();
+    uint32_t now = pros::millis();
+
+    uint32_t elapsed = static_cast<uint32_t>(end - start);
+    uint32_t runs = job.runs + 1;
+    job.totalUs += elapsed;
+    job.lastUs = elapsed;
+    job.avgUs = static_cast<uint32_t>(job.totalUs / runs);
+    if (elapsed > job.maxUs) job.maxUs = elapsed;
+    if (elapsed > job.budgetUs) job.overBudget++;
+    if (runs > 1) {
+        int64_t expected = static_cast<int64_t>(release - job.lastRelease) * 1000;
+        int64_t actual = static_cast<int64_t>(start - job.lastStart);
+        uint32_t jitter = static_cast<uint32_t>(actual > expected ? actual - expected : expected - actual);
+        job.jitterUs = jitter;
+        if (jitter > job.jitterUsMax) job.jitterUsMax = jitter;
+    }
+    job.lastRelease = release;
+    job.lastStart = start;
+    job.runs = runs;
+
+    // the deadline is the next release; keep the phase and skip the releases already over
+    job.nextRelease = release + job.periodMs;
+    if (reached(now, job.nextRelease + 1)) job.deadlineMisses++;
+    while (reached(now, job.nextRelease + 1)) {
+        job.nextRelease += job.periodMs;
+        job.skipped++;
+    }
+}
+
+static void executorLoop() {
+    while (true) {
+        uint32_t now = pros::millis();
+        size_t count = jobCount.load(std::memory_order_acquire);
+        // every due job, shortest period first, until none is due
+        while (true) {
+            Job* due = nullptr;
+            for (size_t i = 0; i < count; i++) {
+                if (!reached(now, jobs[i].nextRelease)) continue;
+                if (due == nullptr || jobs[i].periodMs < due->periodMs) due = &jobs[i];
+            }
+            if (due == nullptr) break;
+            runJob(*due);
+            now = pros::millis();
+        }
+
+        uint32_t wake = now + 10; // jobs added meanwhile wait at most this long
+        for (size_t i = 0; i < count; i++) {
+            if (!reached(jobs[i].nextRelease, wake)) wake = jobs[i].nextRelease;
+        }
+        if (!reached(now, wake)) pros::Task::delay_until(&now, wake - now);
+    }
+}
+
+bool addPeriodicJob(const char* name, uint32_t periodMs, uint32_t budgetUs, void (*run)()) {
+    std::lock_guard<pros::Mutex> lock(addMutex);
+    size_t index = jobCount.load(std::memory_order_relaxed);
+    if (index >= maxJobs || periodMs == 0) return false;
+    Job& job = jobs[index];
+    job.name = name;
+    job.periodMs = periodMs;
+    job.budgetUs = budgetUs;
+    job.run = run;
+    job.nextRelease = pros::millis();
+    // the executor only looks at jobs below the count, so the job is complete before it sees it
+    jobCount.store(index + 1, std::memory_order_release);
+    if (index == 0) {
+        // the priority the separate loops it replaces ran at
+        pros::Task executorTask(executorLoop, TASK_PRIORITY_DEFAULT - 1, TASK_STACK_DEPTH_DEFAULT, "Executor");
+    }
+    return true;
+}
+
+size_t getJobStats(JobStats* out, size_t capacity) {
+    size_t count = jobCount.load(std::memory_order_acquire);
+    if (count > capacity) count = capacity;
+    for (size_t i = 0; i < count; i++) {
+        const Job& job = jobs[i];
+        JobStats& stats = out[i];
+        stats.name = job.name;
+        stats.periodMs = job.periodMs;
+        stats.budgetUs = job.budgetUs;
+        stats.runs = job.runs;
+        stats.lastUs = job.lastUs;
+        stats.maxUs = job.maxUs;
+        stats.avgUs = job.avgUs;
+        stats.jitterUs = job.jitterUs;
+        stats.jitterUsMax = job.jitterUsMax;
+        stats.overBudget = job.overBudget;
+        stats.deadlineMisses = job.deadlineMisses;
+        stats.skipped = job.skipped;
+    }
+    return count;
+}
+
+uint32_t getDeadlineMisses() {
+    uint32_t misses = 0;
+    size_t count = jobCount.load(std::memory_order_acquire);
+    for (size_t i = 0; i < count; i++) misses += jobs[i].deadlineMisses;
+    return misses;
+}
+
+void printExecutorReport() {
+    JobStats stats[maxJobs];
+    size_t count = getJobStats(stats, maxJobs);
+    printf("%-16s %6s %7s %7s %7s %7s %9s %6s %6s %6s\n", "job", "period", "budget", "avg", "max", "runs",
+           "jitter max", "over", "missed", "skip");
+    for (size_t i = 0; i < count; i++) {
+        const JobStats& job = stats[i];
+        printf("%-16s %4lums %5luus %5luus %5luus %7lu %7luus %6lu %6lu %6lu\n", job.name,
+               static_cast<unsigned long>(job.periodMs), static_cast<unsigned long>(job.budgetUs),
+               static_cast<unsigned long>(job.avgUs), static_cast<unsigned long>(job.maxUs),
+               static_cast<unsigned long>(job.runs), static_cast<unsigned long>(job.jitterUsMax),
+               static_cast<unsigned long>(job.overBudget), static_cast<unsigned long>(job.deadlineMisses),
+               static_cast<unsigned long>(job.skipped));
+    }
+}
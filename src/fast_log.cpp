@@ -0,0 +1,89 @@
+#include "main.h"
+#include <cstring>
+#include "fmt/args.h"
+#include "fmt/format.h"
+#include "fast_log.h"
+#include "bounded_buffer.h"
+#include "log_frame.h"
+#include "trace.h"
+
+/* FORMATTING */
+// pushes a raw record argument back into a typed fmt argument
+static void pushArg(fmt::dynamic_format_arg_store<fmt::format_context>& args, LogArgType type, uint64_t bits) {
+    switch (type) {
+        case LogArgType::BOOL: args.push_back(bits != 0); break;
+        case LogArgType::CHAR: args.push_back(static_cast<char>(bits)); break;
+        case LogArgType::I32: args.push_back(static_cast<int32_t>(bits)); break;
+        case LogArgType::U32: args.push_back(static_cast<uint32_t>(bits)); break;
+        case LogArgType::I64: args.push_back(static_cast<int64_t>(bits)); break;
+        case LogArgType::U64: args.push_back(bits); break;
+        case LogArgType::F32: {
+            float value;
+            std::memcpy(&value, &bits, sizeof(value));
+            args.push_back(value);
+            break;
+        }
+        case LogArgType::F64: {
+            double value;
+            std::memcpy(&value, &bits, sizeof(value));
+            args.push_back(value);
+            break;
+        }
+        case LogArgType::STR: args.push_back(reinterpret_cast<const char*>(static_cast<uintptr_t>(bits))); break;
+        case LogArgType::NONE: break;
+    }
+}
+
+static void formatRecord(fmt::memory_buffer& out, const LogRecord& record) {
+    fmt::dynamic_format_arg_store<fmt::format_context> args;
+    for (uint8_t i = 0; i < record.argCount; i++) pushArg(args, record.types[i], record.values[i]);
+    fmt::format_to(std::back_inserter(out), "[{}] {}: ", record.time, record.level);
+    try {
+        fmt::vformat_to(std::back_inserter(out), fmt::string_view(record.format, record.formatLength), args);
+    } catch (const fmt::format_error&) {
+        // formats are checked at compile time, this only guards against a corrupted record
+        fmt::format_to(std::back_inserter(out), "<bad format>");
+    }
+    out.push_back('\n');
+}
+
+/* LOGGER */
+FastLogger::FastLogger()
+    : task([this] { taskLoop(); }, TASK_PRIORITY_MIN + 1, TASK_STACK_DEPTH_DEFAULT, "Fast Logger") {}
+
+void FastLogger::taskLoop() {
+    fmt::memory_buffer out;
+    uint32_t reportedDrops = 0;
+    LogRecord record;
+    // each record goes to boundedStdout() whole, so a burst drops records, not halves of lines or frames
+    auto emit = [&](const LogRecord& record) {
+        out.clear();
+        if (structured) {
+            uint8_t frame[logMaxFrameSize];
+            out.append(frame, frame + encodeLogFrame(record, frame));
+        } else {
+            formatRecord(out, record);
+        }
+        boundedStdout().push(out.data(), out.size());
+    };
+    while (true) {
+        {
+            TRACE_SCOPE("log format");
+            while (ring.tryPop(record)) emit(record);
+        }
+        uint32_t drops = ring.droppedCount();
+        if (drops != reportedDrops) {
+            static constexpr char dropFormat[] = "{} log records dropped";
+            LogRecord dropRecord {dropFormat, sizeof(dropFormat) - 1, lemlib::Level::WARN, 0, pros::millis(), {}, {}};
+            captureLogArgs(dropRecord, drops - reportedDrops);
+            emit(dropRecord);
+            reportedDrops = drops;
+        }
+        pros::delay(10);
+    }
+}
+
+FastLogger& fastLogger() {
+    static FastLogger logger;
+    return logger;
+}
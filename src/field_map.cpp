@@ -0,0 +1,212 @@
+#include "main.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include "auton.h"
+#include "field_map.h"
+
+static constexpr float fieldInches = 144;
+static constexpr float tileInches = 24;
+static constexpr int32_t markerSize = 10;
+static constexpr int32_t noseSize = 4;
+
+static const uint32_t routeColors[] = {0x2196F3, 0x4CAF50, 0xFF9800};
+static const lv_color32_t trailColor = {0x3B, 0xEB, 0xFF, 0xFF}; // yellow, blue green red alpha
+
+static FieldMapConfig config;
+static float scale = 1; // pixels per inch
+static lv_obj_t* canvas = nullptr;
+static lv_obj_t* marker = nullptr;
+static lv_obj_t* nose = nullptr;
+static lv_draw_buf_t* canvasBuffer = nullptr;
+static lv_draw_buf_t* fieldLayer = nullptr; // field and routes, without the trail
+
+static bool hasLast = false;
+static float lastX = 0;
+static float lastY = 0;
+static lv_point_t lastPixel = {0, 0};
+static lv_point_t markerPixel = {-1, -1};
+static lv_point_t nosePixel = {-1, -1};
+static std::atomic<bool> clearRequested = false;
+
+static lv_point_t toPixel(float x, float y) {
+    return {static_cast<int32_t>(std::lround((config.originX + x) * scale)),
+            static_cast<int32_t>(std::lround(config.size - 1 - (config.originY + y) * scale))};
+}
+
+/* CACHED LAYER */
+static void drawLine(lv_layer_t* layer, lv_point_t from, lv_point_t to, lv_color_t color, int32_t width) {
+    lv_draw_line_dsc_t line;
+    lv_draw_line_dsc_init(&line);
+    line.p1 = {static_cast<lv_value_precise_t>(from.x), static_cast<lv_value_precise_t>(from.y)};
+    line.p2 = {static_cast<lv_value_precise_t>(to.x), static_cast<lv_value_precise_t>(to.y)};
+    line.color = color;
+    line.width = width;
+    line.round_start = 1;
+    line.round_end = 1;
+    lv_draw_line(layer, &line);
+}
+
+static void drawWaypoint(lv_layer_t* layer, lv_point_t at, lv_color_t color) {
+    lv_draw_rect_dsc_t dot;
+    lv_draw_rect_dsc_init(&dot);
+    dot.bg_color = color;
+    dot.radius = LV_RADIUS_CIRCLE;
+    lv_area_t area;
+    lv_area_set(&area, at.x - 2, at.y - 2, at.x + 2, at.y + 2);
+    lv_draw_rect(layer, &dot, &area);
+}
+
+static void drawField(lv_layer_t* layer) {
+    int32_t last = config.size - 1;
+    lv_color_t grid = lv_color_hex(0x3A3A3A);
+    for (int i = 1; i < fieldInches / tileInches; i++) {
+        int32_t at = static_cast<int32_t>(std::lround(i * tileInches * scale));
+        drawLine(layer, {at, 0}, {at, last}, grid, 1);
+        drawLine(layer, {0, at}, {last, at}, grid, 1);
+    }
+    lv_draw_rect_dsc_t border;
+    lv_draw_rect_dsc_init(&border);
+    border.bg_opa = LV_OPA_TRANSP;
+    border.border_color = lv_color_hex(0x808080);
+    border.border_width = 1;
+    lv_area_t area;
+    lv_area_set(&area, 0, 0, last, last);
+    lv_draw_rect(layer, &border, &area);
+}
+
+static void drawRoutes(lv_layer_t* layer) {
+    // autonomous() starts at odometry's origin and each route picks up where the last one ended
+    lv_point_t from = toPixel(0, 0);
+    for (size_t r = 0; r < sizeof(autonRoutes) / sizeof(autonRoutes[0]); r++) {
+        lv_color_t color = lv_color_hex(routeColors[r % 3]);
+        for (size_t i = 0; i < autonRoutes[r].count; i++) {
+            const AutonStep& step = autonRoutes[r].steps[i];
+            if (step.action != AutonAction::MOVE) continue;
+            lv_point_t to = toPixel(step.x, step.y);
+            drawLine(layer, from, to, color, 2);
+            drawWaypoint(layer, to, color);
+            from = to;
+        }
+    }
+}
+
+static void renderFieldLayer() {
+    lv_canvas_fill_bg(canvas, lv_color_hex(0x141414), LV_OPA_COVER);
+    lv_layer_t layer;
+    lv_canvas_init_layer(canvas, &layer);
+    drawField(&layer);
+    drawRoutes(&layer);
+    lv_canvas_finish_layer(canvas, &layer);
+    fieldLayer = lv_draw_buf_dup(canvasBuffer);
+}
+
+/* TRAIL */
+static void plot(int32_t x, int32_t y) {
+    // 2x2 dots, a 1 pixel trail is hard to see on the brain screen
+    for (int32_t py = y; py < y + 2; py++) {
+        for (int32_t px = x; px < x + 2; px++) {
+            if (px < 0 || py < 0 || px >= config.size || py >= config.size) continue;
+            uint8_t* row = canvasBuffer->data + py * canvasBuffer->header.stride;
+            reinterpret_cast<lv_color32_t*>(row)[px] = trailColor;
+        }
+    }
+}
+
+/**
+ * Draws the segment straight into the canvas buffer (Bresenham) and invalidates only its bounds.
+ * Drawing through a canvas layer would invalidate the whole canvas
+ */
+static void drawTrailSegment(lv_point_t from, lv_point_t to) {
+    int32_t dx = std::abs(to.x - from.x);
+    int32_t dy = -std::abs(to.y - from.y);
+    int32_t stepX = from.x < to.x ? 1 : -1;
+    int32_t stepY = from.y < to.y ? 1 : -1;
+    int32_t error = dx + dy;
+    lv_point_t at = from;
+    while (true) {
+        plot(at.x, at.y);
+        if (at.x == to.x && at.y == to.y) break;
+        int32_t doubled = 2 * error;
+        if (doubled >= dy) {
+            error += dy;
+            at.x += stepX;
+        }
+        if (doubled <= dx) {
+            error += dx;
+            at.y += stepY;
+        }
+    }
+    lv_area_t coords;
+    lv_obj_get_coords(canvas, &coords);
+    lv_area_t area;
+    lv_area_set(&area, coords.x1 + std::min(from.x, to.x), coords.y1 + std::min(from.y, to.y),
+                coords.x1 + std::max(from.x, to.x) + 1, coords.y1 + std::max(from.y, to.y) + 1);
+    lv_obj_invalidate_area(canvas, &area);
+}
+
+static void moveMarker(lv_obj_t* obj, lv_point_t& shown, lv_point_t at, int32_t size) {
+    if (at.x == shown.x && at.y == shown.y) return;
+    shown = at;
+    lv_obj_set_pos(obj, at.x - size / 2, at.y - size / 2);
+}
+
+static lv_obj_t* createMarker(lv_obj_t* parent, int32_t size, lv_color_t color) {
+    lv_obj_t* obj = lv_obj_create(parent);
+    lv_obj_remove_style_all(obj);
+    lv_obj_set_size(obj, size, size);
+    lv_obj_set_style_radius(obj, LV_RADIUS_CIRCLE, 0);
+    lv_obj_set_style_bg_color(obj, color, 0);
+    lv_obj_set_style_bg_opa(obj, LV_OPA_COVER, 0);
+    lv_obj_add_flag(obj, LV_OBJ_FLAG_HIDDEN);
+    return obj;
+}
+
+lv_obj_t* createFieldMap(lv_obj_t* parent, int32_t x, int32_t y, const FieldMapConfig& mapConfig) {
+    config = mapConfig;
+    scale = config.size / fieldInches;
+
+    lv_obj_t* container = lv_obj_create(parent);
+    lv_obj_remove_style_all(container);
+    lv_obj_set_pos(container, x, y);
+    lv_obj_set_size(container, config.size, config.size);
+    lv_obj_remove_flag(container, LV_OBJ_FLAG_SCROLLABLE);
+
+    canvasBuffer = lv_draw_buf_create(config.size, config.size, LV_COLOR_FORMAT_XRGB8888, 0);
+    canvas = lv_canvas_create(container);
+    lv_canvas_set_draw_buf(canvas, canvasBuffer);
+    renderFieldLayer();
+
+    marker = createMarker(container, markerSize, lv_palette_main(LV_PALETTE_RED));
+    nose = createMarker(container, noseSize, lv_color_white());
+    return container;
+}
+
+void updateFieldMap(float x, float y, float thetaDeg) {
+    if (canvas == nullptr) return;
+    if (clearRequested.exchange(false)) {
+        lv_draw_buf_copy(canvasBuffer, nullptr, fieldLayer, nullptr);
+        lv_obj_invalidate(canvas);
+        hasLast = false;
+    }
+    lv_point_t pixel = toPixel(x, y);
+    if (!hasLast || pixel.x != lastPixel.x || pixel.y != lastPixel.y) {
+        // a jump (setPose) starts a new piece of trail instead of drawing a line across the field
+        if (hasLast && std::hypot(x - lastX, y - lastY) < config.jumpDistance) drawTrailSegment(lastPixel, pixel);
+        lastPixel = pixel;
+        lastX = x;
+        lastY = y;
+    }
+    if (!hasLast) {
+        lv_obj_remove_flag(marker, LV_OBJ_FLAG_HIDDEN);
+        lv_obj_remove_flag(nose, LV_OBJ_FLAG_HIDDEN);
+        hasLast = true;
+    }
+
+    float theta = thetaDeg * static_cast<float>(M_PI) / 180;
+    float reach = (markerSize / 2 + noseSize / 2) / scale;
+    moveMarker(marker, markerPixel, pixel, markerSize);
+    moveMarker(nose, nosePixel, toPixel(x + reach * std::sin(theta), y + reach * std::cos(theta)), noseSize);
+}
+
+void clearFieldMapTrail() { clearRequested = true; }
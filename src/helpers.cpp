@@ -2,6 +2,7 @@
 #include <cmath>
 #include "global.h"
 #include "helpers.h"
+#include "hot_path.h"
 
 void setSpeedIntakeTop(int speed) {
     intakeTop.move(speed);
@@ -13,7 +14,7 @@ void setSpeedIntakeBottom(int speed) {
     pros::delay(10);
 }
 
-double averageImuHeading(double h1, double h2) {
+HOT_PATH double averageImuHeading(double h1, double h2) {
     // convert to unit circle values to prevent naive averaging
     // ex of naive averaging: 359 + 1 => avg of 180, but actual avg is 0!
     // but if we converted them into unit circle value first, then we'd get an avg of 0!
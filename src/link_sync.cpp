@@ -0,0 +1,97 @@
+#include "main.h"
+#include <mutex>
+#include "lemlib/api.hpp"
+#include "global.h"
+#include "link_sync.h"
+#include "pose_feed.h"
+
+/* LINK TRANSPORT */
+// link_transmit() wraps each packet in a start byte, a 16 bit size and a checksum. PROS has no
+// framed size query, so a whole framed packet is waiting once the raw buffer holds this much more
+static constexpr uint32_t linkFrameOverhead = 4;
+
+LinkTransport::LinkTransport(uint8_t port, const char* linkId, bool transmitter)
+    : link(port, linkId, transmitter ? pros::E_LINK_TRANSMITTER : pros::E_LINK_RECIEVER) {}
+
+bool LinkTransport::send(const uint8_t* packet) {
+    if (!link.connected()) return false;
+    return link.transmit(const_cast<uint8_t*>(packet), statePacketSize) == statePacketSize;
+}
+
+bool LinkTransport::receive(uint8_t* out) {
+    if (!link.connected()) return false;
+    uint32_t waiting = link.raw_receivable_size();
+    if (waiting == PROS_ERR || waiting < statePacketSize + linkFrameOverhead) return false;
+    return link.receive(out, statePacketSize) == statePacketSize;
+}
+
+/* STATE */
+static pros::Mutex syncMutex;
+static StateSyncEncoder syncEncoder;
+static StateSyncDecoder syncDecoder;
+static RobotSyncState partnerState;
+static bool hasPartnerState = false;
+static SyncPoint syncPath[syncMaxPathPoints];
+static uint8_t syncPathCount = 0;
+
+static uint8_t sampleMechanism(bool inMotion) {
+    uint8_t bits = 0;
+    if (intakeTop.get_voltage() != 0 || intakeBottom.get_voltage() != 0) bits |= syncIntakeRunning;
+    if (tongueMech.is_extended()) bits |= syncTongueExtended;
+    if (inMotion) bits |= syncInMotion;
+    return bits;
+}
+
+void setSyncPath(const SyncPoint* points, uint8_t count) {
+    std::lock_guard<pros::Mutex> lock(syncMutex);
+    syncPathCount = count < syncMaxPathPoints ? count : syncMaxPathPoints;
+    for (uint8_t i = 0; i < syncPathCount; i++) syncPath[i] = points[i];
+}
+
+bool getPartnerState(RobotSyncState& state) {
+    std::lock_guard<pros::Mutex> lock(syncMutex);
+    state = partnerState;
+    return hasPartnerState;
+}
+
+SyncStats getSyncTxStats() {
+    std::lock_guard<pros::Mutex> lock(syncMutex);
+    return syncEncoder.stats;
+}
+
+SyncStats getSyncRxStats() {
+    std::lock_guard<pros::Mutex> lock(syncMutex);
+    return syncDecoder.stats;
+}
+
+void startStateSync(uint8_t port, bool transmitter, uint32_t periodMs) {
+    // the radio takes a second or two to link up, the task just skips packets until then
+    static LinkTransport transport(port, stateSyncLinkId, transmitter);
+    pros::Task syncTask([periodMs]() {
+        uint32_t lastWake = pros::millis();
+        uint8_t packet[statePacketSize];
+        while (true) {
+            PoseSnapshot pose = latestPose();
+            RobotSyncState ours;
+            ours.x = pose.x;
+            ours.y = pose.y;
+            ours.theta = pose.theta;
+            ours.mechanism = sampleMechanism(pose.inMotion);
+            {
+                std::lock_guard<pros::Mutex> lock(syncMutex);
+                ours.pathCount = syncPathCount;
+                for (uint8_t i = 0; i < syncPathCount; i++) ours.path[i] = syncPath[i];
+                syncEncoder.encode(ours, pros::millis(), packet);
+            }
+            transport.send(packet);
+
+            // drain everything the partner sent since the last cycle, never block on the radio
+            while (transport.receive(packet)) {
+                std::lock_guard<pros::Mutex> lock(syncMutex);
+                if (syncDecoder.decode(packet, pros::millis(), partnerState)) hasPartnerState = true;
+            }
+
+            pros::Task::delay_until(&lastWake, periodMs);
+        }
+    }, TASK_PRIORITY_DEFAULT - 1, TASK_STACK_DEPTH_DEFAULT, "State Sync");
+}
@@ -0,0 +1,49 @@
+#include "main.h"
+#include "lemlib/api.hpp"
+#include "global.h"
+#include "fast_log.h"
+#include "log_bench.h"
+
+// stands in for an expensive log argument, counts how often it is actually evaluated
+static uint32_t evaluations = 0;
+
+static float expensiveValue() {
+    evaluations++;
+    return chassis.getPose().x;
+}
+
+// runs body iterations times and prints the average cost
+template <typename F> static void timeCase(const char* name, uint32_t iterations, F body) {
+    evaluations = 0;
+    uint64_t start = pros::micros();
+    for (uint32_t i = 0; i < iterations; i++) body(i);
+    uint64_t elapsed = pros::micros() - start;
+    printf("%-36s %8.1f ns/call, argument evaluated %lu times\n", name,
+           static_cast<double>(elapsed) * 1000.0 / iterations, static_cast<unsigned long>(evaluations));
+    pros::delay(50); // let the logger task catch up between cases
+}
+
+void runLogBenchmark(uint32_t iterations) {
+    FastLogger& logger = fastLogger();
+    // the level goes back to what it was, the benchmark must not silence the rest of the run
+    lemlib::Level previous = logger.getLowestLevel();
+    logger.setLowestLevel(lemlib::Level::WARN);
+    // a sink of its own, so lemlib's infoSink keeps its level and prints nothing from here
+    lemlib::BaseSink sink;
+    sink.setLowestLevel(lemlib::Level::WARN);
+
+    printf("log benchmark, LOG_MIN_LEVEL=%d, %lu iterations\n", LOG_MIN_LEVEL, static_cast<unsigned long>(iterations));
+    timeCase("empty loop", iterations, [](uint32_t) {});
+    timeCase("FAST_LOG(DEBUG) filtered", iterations,
+             [](uint32_t i) { FAST_LOG(DEBUG, "i={} x={}", i, expensiveValue()); });
+    timeCase("fastLogger().debug() filtered", iterations,
+             [&](uint32_t i) { logger.debug("i={} x={}", i, expensiveValue()); });
+    timeCase("SINK_LOG(sink, DEBUG) filtered", iterations,
+             [&](uint32_t i) { SINK_LOG(&sink, DEBUG, "i={} x={}", i, expensiveValue()); });
+    timeCase("sink.debug() filtered", iterations,
+             [&](uint32_t i) { sink.debug("i={} x={}", i, expensiveValue()); });
+    // enabled deferred logging: only enqueues, keep it under the queue size so nothing drops
+    logger.setLowestLevel(lemlib::Level::INFO);
+    timeCase("fastLogger().warn() enqueued", 128, [&](uint32_t i) { logger.warn("i={} x={}", i, 1.5f); });
+    logger.setLowestLevel(previous);
+}
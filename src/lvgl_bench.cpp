@@ -0,0 +1,263 @@
+#include "main.h"
+#include <atomic>
+#include <cstring>
+#include "liblvgl/lvgl.h"
+#include "format_types.h"
+#include "numeric_label.h"
+#include "lvgl_bench.h"
+
+static constexpr int32_t screenWidth = 480;
+static constexpr int32_t screenHeight = 240;
+static constexpr size_t labelCount = 24;
+static constexpr size_t readoutCount = 10;
+static constexpr int32_t canvasSize = 240;
+
+/* SCENES */
+struct BenchScene {
+    const char* name;
+    void (*build)(lv_obj_t* screen);
+    void (*frame)(uint32_t i); // changes what the scene would change in one refresh
+    void (*teardown)() = nullptr; // frees what deleting the screen does not
+};
+
+static lv_obj_t* benchScreen = nullptr;
+static lv_obj_t* labels[labelCount];
+static lv_obj_t* chart = nullptr;
+static lv_chart_series_t* series[2] = {};
+static lv_obj_t* canvas = nullptr;
+static lv_draw_buf_t* canvasBuffer = nullptr;
+static GlyphAtlas* atlas = nullptr;
+static NumericLabel* readouts[readoutCount];
+static lv_color_format_t colorFormat = LV_COLOR_FORMAT_XRGB8888;
+
+static void buildLabels(lv_obj_t* screen) {
+    for (size_t i = 0; i < labelCount; i++) {
+        labels[i] = lv_label_create(screen);
+        lv_label_set_long_mode(labels[i], LV_LABEL_LONG_CLIP);
+        lv_obj_set_pos(labels[i], static_cast<int32_t>(i % 4) * 120 + 4, static_cast<int32_t>(i / 4) * 40);
+        lv_obj_set_size(labels[i], 112, 36);
+        lv_obj_set_style_text_font(labels[i], &lv_font_montserrat_18, 0);
+        lv_label_set_text(labels[i], "0.00");
+    }
+}
+
+static void setLabel(size_t index, uint32_t i) {
+    char text[16];
+    formatInto(text, "{:.2f}", i * 0.37f + index);
+    lv_label_set_text(labels[index], text);
+}
+
+static void buildReadouts(lv_obj_t* screen) {
+    atlas = new GlyphAtlas(&lv_font_montserrat_18, lv_color_white(), lv_color_black());
+    for (size_t i = 0; i < readoutCount; i++) {
+        readouts[i] = new NumericLabel(screen, *atlas, 9);
+        lv_obj_set_pos(readouts[i]->obj(), static_cast<int32_t>(i % 4) * 120 + 4, static_cast<int32_t>(i / 4) * 40);
+    }
+}
+
+static void deleteReadouts() {
+    for (NumericLabel*& readout : readouts) {
+        delete readout;
+        readout = nullptr;
+    }
+    delete atlas;
+    atlas = nullptr;
+}
+
+static void deleteCanvas() {
+    lv_obj_delete(canvas); // before the buffer it draws from
+    lv_draw_buf_destroy(canvasBuffer);
+    canvasBuffer = nullptr;
+}
+
+static void buildChart(lv_obj_t* screen, lv_chart_update_mode_t mode) {
+    chart = lv_chart_create(screen);
+    lv_obj_set_size(chart, screenWidth, screenHeight);
+    lv_chart_set_update_mode(chart, mode);
+    lv_chart_set_point_count(chart, 100);
+    lv_chart_set_range(chart, LV_CHART_AXIS_PRIMARY_Y, -100, 100);
+    lv_obj_set_style_size(chart, 0, 0, LV_PART_INDICATOR);
+    series[0] = lv_chart_add_series(chart, lv_palette_main(LV_PALETTE_BLUE), LV_CHART_AXIS_PRIMARY_Y);
+    series[1] = lv_chart_add_series(chart, lv_palette_main(LV_PALETTE_ORANGE), LV_CHART_AXIS_PRIMARY_Y);
+}
+
+static void buildCanvas(lv_obj_t* screen) {
+    canvasBuffer = lv_draw_buf_create(canvasSize, canvasSize, colorFormat, 0);
+    canvas = lv_canvas_create(screen);
+    lv_canvas_set_draw_buf(canvas, canvasBuffer);
+    lv_canvas_fill_bg(canvas, lv_color_hex(0x141414), LV_OPA_COVER);
+}
+
+static lv_point_t canvasPoint(uint32_t i) {
+    // walks a diagonal, like a robot trail
+    return {static_cast<int32_t>(i * 3 % (canvasSize - 8)), static_cast<int32_t>(i * 2 % (canvasSize - 8))};
+}
+
+static const BenchScene scenes[] = {
+    {"full repaint", buildLabels, [](uint32_t) { lv_obj_invalidate(benchScreen); }},
+    {"24 labels, all changed", buildLabels,
+     [](uint32_t i) {
+         for (size_t l = 0; l < labelCount; l++) setLabel(l, i);
+     }},
+    {"24 labels, 3 changed", buildLabels,
+     [](uint32_t i) {
+         for (size_t l = 0; l < 3; l++) setLabel((i * 3 + l) % labelCount, i);
+     }},
+    // ten values like the dashboard's, through the font path and through the glyph atlas
+    {"10 labels, all changed", buildLabels,
+     [](uint32_t i) {
+         for (size_t l = 0; l < readoutCount; l++) setLabel(l, i);
+     }},
+    {"10 numeric labels", buildReadouts,
+     [](uint32_t i) {
+         for (size_t l = 0; l < readoutCount; l++) readouts[l]->setValue(i * 0.37f + l, 2);
+     },
+     deleteReadouts},
+    {"chart shift", [](lv_obj_t* screen) { buildChart(screen, LV_CHART_UPDATE_MODE_SHIFT); },
+     [](uint32_t i) {
+         lv_chart_set_next_value(chart, series[0], static_cast<int32_t>(i * 7 % 200) - 100);
+         lv_chart_set_next_value(chart, series[1], static_cast<int32_t>(i * 13 % 200) - 100);
+     }},
+    {"chart circular", [](lv_obj_t* screen) { buildChart(screen, LV_CHART_UPDATE_MODE_CIRCULAR); },
+     [](uint32_t i) {
+         lv_chart_set_next_value(chart, series[0], static_cast<int32_t>(i * 7 % 200) - 100);
+         lv_chart_set_next_value(chart, series[1], static_cast<int32_t>(i * 13 % 200) - 100);
+     }},
+    {"canvas layer line", buildCanvas,
+     [](uint32_t i) {
+         // drawing through a layer invalidates the whole canvas
+         lv_point_t from = canvasPoint(i);
+         lv_layer_t layer;
+         lv_canvas_init_layer(canvas, &layer);
+         lv_draw_line_dsc_t line;
+         lv_draw_line_dsc_init(&line);
+         line.p1 = {static_cast<lv_value_precise_t>(from.x), static_cast<lv_value_precise_t>(from.y)};
+         line.p2 = {static_cast<lv_value_precise_t>(from.x + 3), static_cast<lv_value_precise_t>(from.y + 2)};
+         line.color = lv_color_white();
+         line.width = 2;
+         lv_draw_line(&layer, &line);
+         lv_canvas_finish_layer(canvas, &layer);
+     },
+     deleteCanvas},
+    {"canvas direct pixels", buildCanvas,
+     [](uint32_t i) {
+         // the field map's approach: write the pixels, invalidate their bounds
+         lv_point_t at = canvasPoint(i);
+         uint32_t pixelSize = lv_color_format_get_size(colorFormat);
+         for (int32_t y = at.y; y < at.y + 4; y++) {
+             std::memset(lv_draw_buf_goto_xy(canvasBuffer, at.x, y), 0xFF, 4 * pixelSize);
+         }
+         lv_area_t coords;
+         lv_obj_get_coords(canvas, &coords);
+         lv_area_t area;
+         lv_area_set(&area, coords.x1 + at.x, coords.y1 + at.y, coords.x1 + at.x + 3, coords.y1 + at.y + 3);
+         lv_obj_invalidate_area(canvas, &area);
+     },
+     deleteCanvas},
+};
+
+/* MEASUREMENT */
+static uint32_t invalidatedAreas = 0;
+static uint64_t invalidatedPixels = 0;
+
+static void onInvalidate(lv_event_t* e) {
+    invalidatedAreas++;
+    invalidatedPixels += lv_area_get_size(static_cast<lv_area_t*>(lv_event_get_param(e)));
+}
+
+static void runScene(lv_display_t* display, const char* formatName, const BenchScene& scene, uint32_t frames) {
+    // new screens go to the default display, only switch it for as long as that takes
+    lv_display_t* defaultDisplay = lv_display_get_default();
+    lv_display_set_default(display);
+    benchScreen = lv_obj_create(nullptr);
+    lv_display_set_default(defaultDisplay);
+    lv_obj_remove_flag(benchScreen, LV_OBJ_FLAG_SCROLLABLE);
+    scene.build(benchScreen);
+    lv_screen_load(benchScreen);
+    lv_refr_now(display); // first frame draws everything, not part of the numbers
+
+    invalidatedAreas = 0;
+    invalidatedPixels = 0;
+    uint64_t updateTotal = 0;
+    uint64_t renderTotal = 0;
+    uint32_t renderMax = 0;
+    for (uint32_t i = 0; i < frames; i++) {
+        uint64_t start = pros::micros();
+        scene.frame(i);
+        uint64_t updated = pros::micros();
+        lv_refr_now(display);
+        uint32_t render = static_cast<uint32_t>(pros::micros() - updated);
+        updateTotal += updated - start;
+        renderTotal += render;
+        if (render > renderMax) renderMax = render;
+    }
+    // teardowns delete their own objects, so they run before the screen goes
+    if (scene.teardown != nullptr) scene.teardown();
+    lv_obj_delete(benchScreen);
+
+    double pixelsPerFrame = static_cast<double>(invalidatedPixels) / frames;
+    printf("%-9s %-24s %8.0f %8.0f %8lu %6.1f %9.0f %5.1f%% %7.1f\n", formatName, scene.name,
+           static_cast<double>(updateTotal) / frames, static_cast<double>(renderTotal) / frames,
+           static_cast<unsigned long>(renderMax), static_cast<double>(invalidatedAreas) / frames, pixelsPerFrame,
+           pixelsPerFrame * 100 / (screenWidth * screenHeight),
+           pixelsPerFrame > 0 ? static_cast<double>(renderTotal) * 1000 / invalidatedPixels : 0.0);
+}
+
+/* RUN */
+static constexpr struct {
+    const char* name;
+    lv_color_format_t format;
+} formats[] = {{"RGB565", LV_COLOR_FORMAT_RGB565},
+               {"RGB888", LV_COLOR_FORMAT_RGB888},
+               {"XRGB8888", LV_COLOR_FORMAT_XRGB8888},
+               {"ARGB8888", LV_COLOR_FORMAT_ARGB8888}};
+
+struct BenchRun {
+    uint32_t frames;
+    size_t format = 0;
+    size_t scene = 0;
+    lv_display_t* display = nullptr;
+    lv_draw_buf_t* buffer = nullptr;
+    std::atomic<bool> done = false;
+};
+
+static void createBenchDisplay(BenchRun& run) {
+    lv_color_format_t format = formats[run.format].format;
+    run.display = lv_display_create(screenWidth, screenHeight);
+    // only rendered by lv_refr_now() in runScene(), never by LVGL's refresh timer
+    lv_display_delete_refr_timer(run.display);
+    lv_display_set_color_format(run.display, format);
+    run.buffer = lv_draw_buf_create(screenWidth, screenHeight, format, 0);
+    lv_display_set_draw_buffers(run.display, run.buffer, nullptr);
+    lv_display_set_render_mode(run.display, LV_DISPLAY_RENDER_MODE_PARTIAL);
+    lv_display_set_flush_cb(run.display, [](lv_display_t* d, const lv_area_t*, uint8_t*) { lv_display_flush_ready(d); });
+    lv_display_add_event_cb(run.display, onInvalidate, LV_EVENT_INVALIDATE_AREA, nullptr);
+    colorFormat = format;
+}
+
+// an lv_timer callback, one scene per call: LVGL has no lock in this build, so the benchmark runs
+// on LVGL's task, and the real screen refreshes between scenes
+static void benchStep(lv_timer_t* timer) {
+    BenchRun& run = *static_cast<BenchRun*>(lv_timer_get_user_data(timer));
+    if (run.display == nullptr) createBenchDisplay(run);
+    runScene(run.display, formats[run.format].name, scenes[run.scene], run.frames);
+    if (++run.scene < sizeof(scenes) / sizeof(scenes[0])) return;
+    lv_display_delete(run.display);
+    lv_draw_buf_destroy(run.buffer);
+    run.display = nullptr;
+    run.scene = 0;
+    if (++run.format < sizeof(formats) / sizeof(formats[0])) return;
+    lv_timer_delete(timer);
+    run.done = true;
+}
+
+void runLvglBenchmark(uint32_t frames) {
+    printf("lvgl benchmark, %dx%d, %lu frames per scene, times in us\n", screenWidth, screenHeight,
+           static_cast<unsigned long>(frames));
+    printf("%-9s %-24s %8s %8s %8s %6s %9s %6s %7s\n", "format", "scene", "update", "render", "max", "areas",
+           "px/frame", "screen", "ns/px");
+    BenchRun run;
+    run.frames = frames;
+    lv_timer_create(benchStep, 20, &run);
+    while (!run.done) pros::delay(20);
+}
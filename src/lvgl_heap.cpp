@@ -0,0 +1,90 @@
+#include "main.h"
+#include <atomic>
+#include "liblvgl/lvgl.h"
+#include "fast_log.h"
+#include "lvgl_heap.h"
+
+static constexpr uint32_t poolRounding = 64 * 1024;
+
+static std::atomic<uint32_t> totalBytes = 0;
+static std::atomic<uint32_t> usedBytes = 0;
+static std::atomic<uint32_t> peakUsedBytes = 0;
+static std::atomic<uint32_t> largestFreeBlock = 0;
+static std::atomic<uint32_t> usedBlocks = 0;
+static std::atomic<uint8_t> fragmentationPct = 0;
+static std::atomic<float> allocationRate = 0;
+static std::atomic<uint32_t> lowHeadroomAlerts = 0;
+
+// the monitor timer's own, it only runs on LVGL's task
+static uint32_t minHeadroomBytes = 0;
+static uint32_t lastUsed = 0;
+static uint32_t lastTime = 0;
+static bool low = false;
+
+// an lv_timer callback: LVGL has no lock in this build (LV_USE_OS is unset), so its heap is only
+// walked from its own task, where nothing can allocate from it mid-walk
+static void checkHeap(lv_timer_t*) {
+    lv_mem_monitor_t monitor;
+    lv_mem_monitor(&monitor); // walks the heap, hence the slow period
+    uint32_t now = pros::millis();
+    uint32_t used = static_cast<uint32_t>(monitor.total_size - monitor.free_size);
+
+    totalBytes = static_cast<uint32_t>(monitor.total_size);
+    usedBytes = used;
+    peakUsedBytes = static_cast<uint32_t>(monitor.max_used);
+    largestFreeBlock = static_cast<uint32_t>(monitor.free_biggest_size);
+    usedBlocks = static_cast<uint32_t>(monitor.used_cnt);
+    fragmentationPct = monitor.frag_pct;
+    if (lastTime != 0 && now > lastTime) {
+        allocationRate = (static_cast<float>(used) - static_cast<float>(lastUsed)) * 1000 / (now - lastTime);
+    }
+    lastUsed = used;
+    lastTime = now;
+
+    // alert once per dip, not on every check while it lasts
+    if (!low && monitor.free_biggest_size < minHeadroomBytes) {
+        low = true;
+        lowHeadroomAlerts++;
+        fastLogger().warn("lvgl heap low: largest free block {} bytes, {} used, {}% fragmented",
+                          static_cast<uint32_t>(monitor.free_biggest_size), used, monitor.frag_pct);
+    } else if (low && monitor.free_biggest_size >= minHeadroomBytes * 2) {
+        low = false;
+    }
+}
+
+void startLvglHeapMonitor(uint32_t periodMs, uint32_t minHeadroomBytes) {
+    ::minHeadroomBytes = minHeadroomBytes;
+    lv_timer_create(checkHeap, periodMs, nullptr);
+}
+
+LvglHeapStats getLvglHeapStats() {
+    LvglHeapStats stats;
+    stats.totalBytes = totalBytes;
+    stats.usedBytes = usedBytes;
+    stats.peakUsedBytes = peakUsedBytes;
+    stats.largestFreeBlock = largestFreeBlock;
+    stats.usedBlocks = usedBlocks;
+    stats.fragmentationPct = fragmentationPct;
+    stats.allocationRate = allocationRate;
+    stats.lowHeadroomAlerts = lowHeadroomAlerts;
+    return stats;
+}
+
+uint32_t recommendedLvglPoolSize() {
+    uint32_t withMargin = peakUsedBytes + peakUsedBytes / 4;
+    return (withMargin + poolRounding - 1) / poolRounding * poolRounding;
+}
+
+void printLvglHeapReport() {
+    LvglHeapStats stats = getLvglHeapStats();
+    uint32_t recommended = recommendedLvglPoolSize();
+    printf("lvgl heap: %lu of %lu bytes used, peak %lu, largest free block %lu, %u%% fragmented, %lu low alerts\n",
+           static_cast<unsigned long>(stats.usedBytes), static_cast<unsigned long>(stats.totalBytes),
+           static_cast<unsigned long>(stats.peakUsedBytes), static_cast<unsigned long>(stats.largestFreeBlock),
+           stats.fragmentationPct, static_cast<unsigned long>(stats.lowHeadroomAlerts));
+    if (recommended != 0 && recommended < stats.totalBytes) {
+        printf("lvgl heap: LV_MEM_SIZE could be %luU (%lu KB), giving %lu KB back to the program\n",
+               static_cast<unsigned long>(recommended), static_cast<unsigned long>(recommended / 1024),
+               static_cast<unsigned long>((stats.totalBytes - recommended) / 1024));
+    }
+}
@@ -6,6 +6,22 @@
 #include "global.h"
 #include "helpers.h"
 #include "auton.h"
+#include "auton_actions.h"
+#include "telemetry.h"
+#include "fast_log.h"
+#include "sd_logger.h"
+#include "signals.h"
+#include "sensor_recorder.h"
+#include "dashboard.h"
+#include "field_map.h"
+#include "lvgl_heap.h"
+#include "trace.h"
+#include "task_profiler.h"
+#include "pose_feed.h"
+#include "executor.h"
+#include "alloc_audit.h"
+#include "log_bench.h"
+#include "lvgl_bench.h"
 #include <algorithm>
 
 /* CONTROLLER */
@@ -19,9 +35,15 @@ pros::Controller controller(pros::E_CONTROLLER_MASTER); // not in global since n
  * to keep execution time for this mode under a few seconds.
  */
 void initialize() {
+    setAllocPhase(AllocPhase::INITIALIZE);
     pros::lcd::initialize();
     pros::lcd::set_text(0, "Initializing...");
 
+    // start the logging task now so control loops only ever enqueue
+    fastLogger();
+    // a new file on the card for this run, telemetry is recorded there at full rate
+    sdLogger().start();
+
     // calibrating imus
     imu.reset();
     imu2.reset();
@@ -40,35 +62,54 @@ void initialize() {
 	pros::lcd::set_text(0, "Done initializing!");
 	pros::delay(1000); // so the message can appear on screen before telemetry
 
-    // --- TELEMETRY TASK ---
-    // prints position + telemetry to LCD every 50ms
-    pros::Task screenTask([&]() {
-        while (true) {
-            lemlib::Pose pose = chassis.getPose();
-
-            pros::lcd::print(0, "X: %f", pose.x);
-            pros::lcd::print(1, "Y: %f", pose.y);
-            pros::lcd::print(2, "Theta: %f", pose.theta);
-
-            pros::lcd::print(3, "IMU1 Heading: %f", imu.get_heading());
-			pros::lcd::print(4, "IMU2 Heading: %f", imu2.get_heading());
-			pros::lcd::print(5, "AVG IMU Heading: %f", averageImuHeading(imu.get_heading(), imu2.get_heading()));
-			pros::lcd::print(6, "IMU1 Orientation: %f", imu.get_physical_orientation());
-			pros::lcd::print(7, "IMU2 Orientation: %f", imu2.get_physical_orientation());
-
-			pros::lcd::print(8, "Rotation Sensor: %i", verticalEncoder.get_position());
-
-            pros::delay(100);
-        }
-    });
-
-    
+    // the pose every other task reads (latestPose()), without touching lemlib or its mutex
+    startPoseFeed(10);
+
+    // telemetry, signal sampling, sensor recording and task profiling are jobs on one executor
+    // task (executor.h), printExecutorReport() shows their timing
+    // binary pose/pid/motor telemetry over the usb link, decode with tools/telemetry_decode
+    startTelemetryStream(10);
+
+    // every signal in src/signals.cpp at 100 Hz: the card keeps them all, the screen shows 10 Hz
+    startSignalSampler(10);
+    startSignalOutput(SignalOutput::SD, 1);
+    // replaces the llemu text, only labels whose values moved get redrawn
+    startDashboard(100);
+    // lvgl_heap_* signals, and a warning in the log if the screen runs LVGL's pool low
+    startLvglHeapMonitor(500);
+    // cpu_busy and stack_free_min signals, per task "P," lines on the card
+    startTaskProfiler(1000);
+    // heap use per phase and task; executor jobs and the opcontrol loop must not allocate
+    startAllocAudit(AllocAlarm::LOG);
+#if TRACE_ENABLED
+    // timeline of the TRACE_* points and LVGL's refreshes, extract with tools/trace_extract
+    traceLvglRefresh();
+    startTrace(TraceOutput::SD);
+#endif
+    // raw sensor reads for offline replay, see tools/sensor_replay
+    startSensorRecording(10);
+#if LVGL_BENCH_ENABLED
+    // render cost per scene and color format, printed to the terminal; make LVGL_BENCH=1
+    runLvglBenchmark();
+#endif
+#if LOG_BENCH_ENABLED
+    // cost of each logging path, printed to the terminal; make LOG_BENCH=1
+    runLogBenchmark();
+#endif
 }
 
 /**
  * Runs while the robot is disabled
  */
-void disabled() {}
+void disabled() {
+    setAllocPhase(AllocPhase::DISABLED);
+    // the match is over (or paused), get everything onto the card before power may be cut
+    printLvglHeapReport();
+    printTaskProfiles();
+    printExecutorReport();
+    printAllocReport();
+    sdLogger().flush();
+}
 
 /**
  * runs after initialize if the robot is connected to field control
@@ -80,6 +121,8 @@ void competition_initialize() {
 // get a path used for pure pursuit
 // this needs to be put outside a function
 //ASSET(example_txt); // '.' replaced with "_" to make c++ happy
+// files listed in COMPRESS_ASSETS (Makefile) are linked compressed, use example_txt.get() as the asset
+//COMPRESSED_ASSET(example_txt);
 
 /**
  * Runs during auto
@@ -87,33 +130,31 @@ void competition_initialize() {
  * This is an example autonomous routine which demonstrates a lot of the features LemLib has to offer
  */
 void autonomous() {
+    setAllocPhase(AllocPhase::AUTONOMOUS);
     // initializing starting position
     double averageHeading = averageImuHeading(imu.get_heading(), imu2.get_heading());
     chassis.setPose(0, 0, averageHeading);
+    clearFieldMapTrail(); // the dashboard's map shows this run only
     tongueMech.extend(); // just to ensure tongue is up as we will not be using the loaders for this routine
     
     // block pickup whilst traveling to long goal
     setSpeedIntakeBottom(115);
 
-    // route one (collecting blocks and scoring)
-    autonRouteOne();
-	pros::delay(200);
-    // route two (go to new start point, collect blocks and score)
-    autonRouteTwo();
-	pros::delay(200);
-    // route three (parking)
-    autonRouteThree();
-    
-
+    // the routes as coroutine actions (auton_actions.h). No time limit of its own: competition
+    // control ends the period, and a skills run needs every route, parking included
+    auton::run(matchAuton);
 }
 
 /**
  * Runs in driver control
  */
 void opcontrol() {
+    setAllocPhase(AllocPhase::OPCONTROL);
     competition_initialize();
-    // loop to continuously update motors
+    // loop to continuously update motors, every 25 ms from the start however long an iteration takes
+    uint32_t lastWake = pros::millis();
     while (true) {
+        NoAllocScope noAlloc("opcontrol loop");
 
 		/* CONTROLS */
 		// running intake motors forward/backward
@@ -133,6 +174,6 @@ void opcontrol() {
         // move the chassis with curvature drive
         chassis.tank(leftY, rightY);
         // delay to save resources
-        pros::delay(25);
+        pros::Task::delay_until(&lastWake, 25);
     }
 }
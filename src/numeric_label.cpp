@@ -0,0 +1,135 @@
+#include "main.h"
+#include <algorithm>
+#include <cstring>
+#include "format_types.h"
+#include "numeric_label.h"
+
+static constexpr char atlasChars[] = "0123456789-+. ";
+static constexpr size_t atlasCount = sizeof(atlasChars) - 1;
+
+static size_t atlasIndex(char c) { return static_cast<size_t>(std::strchr(atlasChars, c) - atlasChars); }
+
+/* GLYPH ATLAS */
+GlyphAtlas::GlyphAtlas(const lv_font_t* font, lv_color_t text, lv_color_t background)
+    : font(font),
+      textColor(text),
+      background(background) {
+    // one width for every cell, so digits line up and a cell is a fixed rectangle
+    for (size_t i = 0; i < atlasCount; i++) {
+        width = std::max<int32_t>(width, lv_font_get_glyph_width(font, atlasChars[i], 0));
+    }
+    height = lv_font_get_line_height(font);
+    atlas = lv_draw_buf_create(width * atlasCount, height, LV_COLOR_FORMAT_XRGB8888, 0);
+
+    // the normal font path, once per character, through a throwaway hidden canvas
+    lv_obj_t* canvas = lv_canvas_create(lv_layer_top());
+    lv_obj_add_flag(canvas, LV_OBJ_FLAG_HIDDEN);
+    lv_canvas_set_draw_buf(canvas, atlas);
+    lv_canvas_fill_bg(canvas, background, LV_OPA_COVER);
+    char texts[atlasCount][2] = {};
+    lv_layer_t layer;
+    lv_canvas_init_layer(canvas, &layer);
+    for (size_t i = 0; i < atlasCount; i++) {
+        texts[i][0] = atlasChars[i];
+        lv_draw_label_dsc_t label;
+        lv_draw_label_dsc_init(&label);
+        label.text = texts[i];
+        label.font = font;
+        label.color = text;
+        label.align = LV_TEXT_ALIGN_CENTER;
+        lv_area_t area = cell(atlasChars[i]);
+        lv_draw_label(&layer, &label, &area);
+    }
+    lv_canvas_finish_layer(canvas, &layer);
+    lv_obj_delete(canvas);
+}
+
+GlyphAtlas::~GlyphAtlas() { lv_draw_buf_destroy(atlas); }
+
+bool GlyphAtlas::has(char c) const { return c != '\0' && std::strchr(atlasChars, c) != nullptr; }
+
+lv_area_t GlyphAtlas::cell(char c) const {
+    int32_t x = static_cast<int32_t>(atlasIndex(c)) * width;
+    lv_area_t area;
+    lv_area_set(&area, x, 0, x + width - 1, height - 1);
+    return area;
+}
+
+/* NUMERIC LABEL */
+NumericLabel::NumericLabel(lv_obj_t* parent, const GlyphAtlas& atlas, size_t chars)
+    : atlas(atlas),
+      chars(std::min(chars, sizeof(shown) - 1)) {
+    int32_t width = atlas.cellWidth() * static_cast<int32_t>(this->chars);
+    container = lv_obj_create(parent);
+    lv_obj_remove_style_all(container);
+    lv_obj_set_size(container, width, atlas.cellHeight());
+    lv_obj_remove_flag(container, LV_OBJ_FLAG_SCROLLABLE);
+
+    cells = lv_draw_buf_create(width, atlas.cellHeight(), LV_COLOR_FORMAT_XRGB8888, 0);
+    canvas = lv_canvas_create(container);
+    lv_canvas_set_draw_buf(canvas, cells);
+    lv_canvas_fill_bg(canvas, atlas.getBackground(), LV_OPA_COVER);
+
+    fallbackLabel = lv_label_create(container);
+    lv_label_set_long_mode(fallbackLabel, LV_LABEL_LONG_CLIP);
+    lv_obj_set_size(fallbackLabel, width, atlas.cellHeight());
+    lv_obj_set_style_text_font(fallbackLabel, atlas.getFont(), 0);
+    lv_obj_set_style_text_color(fallbackLabel, atlas.getTextColor(), 0);
+    lv_obj_set_style_text_align(fallbackLabel, LV_TEXT_ALIGN_RIGHT, 0);
+    lv_obj_add_flag(fallbackLabel, LV_OBJ_FLAG_HIDDEN);
+}
+
+NumericLabel::~NumericLabel() {
+    lv_obj_delete(container);
+    lv_draw_buf_destroy(cells);
+}
+
+void NumericLabel::showFallback(bool fallback) {
+    if (fallback == usingFallback) return;
+    usingFallback = fallback;
+    if (fallback) {
+        lv_obj_add_flag(canvas, LV_OBJ_FLAG_HIDDEN);
+        lv_obj_remove_flag(fallbackLabel, LV_OBJ_FLAG_HIDDEN);
+    } else {
+        lv_obj_add_flag(fallbackLabel, LV_OBJ_FLAG_HIDDEN);
+        lv_obj_remove_flag(canvas, LV_OBJ_FLAG_HIDDEN);
+    }
+}
+
+size_t NumericLabel::setText(const char* text) {
+    size_t length = std::strlen(text);
+    bool fits = length <= chars;
+    for (size_t i = 0; fits && i < length; i++) fits = atlas.has(text[i]);
+    if (!fits) {
+        showFallback(true);
+        lv_label_set_text(fallbackLabel, text);
+        return chars;
+    }
+    showFallback(false);
+
+    lv_area_t coords;
+    lv_obj_get_coords(canvas, &coords);
+    int32_t cellWidth = atlas.cellWidth();
+    size_t padding = chars - length;
+    size_t redrawn = 0;
+    for (size_t i = 0; i < chars; i++) {
+        char c = i < padding ? ' ' : text[i - padding];
+        if (shown[i] == c) continue;
+        shown[i] = c;
+        int32_t x = static_cast<int32_t>(i) * cellWidth;
+        lv_area_t destination;
+        lv_area_set(&destination, x, 0, x + cellWidth - 1, atlas.cellHeight() - 1);
+        lv_area_t source = atlas.cell(c);
+        lv_draw_buf_copy(cells, &destination, atlas.buffer(), &source);
+        lv_area_move(&destination, coords.x1, coords.y1);
+        lv_obj_invalidate_area(canvas, &destination);
+        redrawn++;
+    }
+    return redrawn;
+}
+
+size_t NumericLabel::setValue(float value, int decimals) {
+    char text[sizeof(shown)];
+    formatInto(text, "{:.{}f}", value, decimals);
+    return setText(text);
+}
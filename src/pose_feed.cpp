@@ -0,0 +1,68 @@
+#include "main.h"
+#include <atomic>
+#include "lemlib/api.hpp"
+#include "lemlib/chassis/odom.hpp"
+#include "global.h"
+#include "seqlock.h"
+#include "trace.h"
+#include "pose_feed.h"
+
+static Seqlock<PoseSnapshot> poseLock;
+static std::atomic<uint32_t> publishMicros = 0;
+static std::atomic<uint32_t> publishMicrosMax = 0;
+static std::atomic<uint32_t> readRetries = 0;
+
+static void publishPose() {
+    uint64_t start = pros::micros();
+    lemlib::Pose pose = chassis.getPose();
+    lemlib::Pose speed = lemlib::getSpeed();
+    PoseSnapshot snapshot;
+    snapshot.x = pose.x;
+    snapshot.y = pose.y;
+    snapshot.theta = pose.theta;
+    snapshot.xSpeed = speed.x;
+    snapshot.ySpeed = speed.y;
+    snapshot.thetaSpeed = speed.theta;
+    snapshot.inMotion = chassis.isInMotion();
+    snapshot.timeMs = pros::millis();
+    poseLock.publish(snapshot);
+
+    uint32_t elapsed = static_cast<uint32_t>(pros::micros() - start);
+    publishMicros = elapsed;
+    if (elapsed > publishMicrosMax) publishMicrosMax = elapsed;
+}
+
+void startPoseFeed(uint32_t periodMs) {
+    publishPose(); // readers started after this never see the all zero snapshot
+    pros::Task feedTask([periodMs]() {
+        uint32_t lastWake = pros::millis();
+        while (true) {
+            TRACE_BEGIN("pose publish");
+            publishPose();
+            TRACE_END("pose publish");
+            pros::Task::delay_until(&lastWake, periodMs);
+        }
+    }, TASK_PRIORITY_DEFAULT - 1, TASK_STACK_DEPTH_DEFAULT, "Pose Feed");
+}
+
+PoseSnapshot latestPose() {
+    PoseSnapshot snapshot;
+    uint32_t retries = 0;
+    // on one core a read fails either because the publisher preempted it, and the retry succeeds,
+    // or because this task preempted the publisher mid-publish. Spinning would keep a lower
+    // priority publisher from finishing, so the second failure sleeps
+    while (!poseLock.tryRead(snapshot)) {
+        if (++retries > 1) pros::delay(1);
+    }
+    if (retries != 0) readRetries += retries;
+    return snapshot;
+}
+
+PoseFeedStats getPoseFeedStats() {
+    PoseFeedStats stats;
+    stats.publishes = poseLock.version();
+    stats.publishMicros = publishMicros;
+    stats.publishMicrosMax = publishMicrosMax;
+    stats.readRetries = readRetries;
+    return stats;
+}
@@ -0,0 +1,43 @@
+#include "main.h"
+#include "sd_logger.h"
+#include "trace.h"
+
+// start a new file every 16 MB so a long session can still be copied off in pieces
+static constexpr uint32_t maxFileBytes = 16 * 1024 * 1024;
+// how often the task checks for full buffers. 8 KB every 20 ms is far above any producer's rate
+static constexpr uint32_t servicePeriodMs = 20;
+
+SdLogger::SdLogger()
+    : log("/usd/", "run", maxFileBytes),
+      task([this] { taskLoop(); }, TASK_PRIORITY_MIN + 1, TASK_STACK_DEPTH_DEFAULT, "SD Logger") {}
+
+bool SdLogger::start() {
+    if (open) return true;
+    if (!pros::usd::is_installed()) return false;
+    open = log.open();
+    return open;
+}
+
+bool SdLogger::write(const void* data, size_t length) {
+    if (!open) return false;
+    return log.append(data, length);
+}
+
+void SdLogger::flush() {
+    flushRequested = true;
+    task.notify();
+}
+
+void SdLogger::taskLoop() {
+    while (true) {
+        pros::Task::notify_take(true, servicePeriodMs);
+        if (!open) continue;
+        TRACE_SCOPE("sd service");
+        log.service(flushRequested.exchange(false));
+    }
+}
+
+SdLogger& sdLogger() {
+    static SdLogger logger;
+    return logger;
+}
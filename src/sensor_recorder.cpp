@@ -0,0 +1,59 @@
+#include "main.h"
+#include <atomic>
+#include "lemlib/api.hpp"
+#include "global.h"
+#include "sd_logger.h"
+#include "sensor_recorder.h"
+#include "hot_path.h"
+#include "executor.h"
+
+static std::atomic<uint32_t> framesRecorded = 0;
+
+static uint16_t readButtons(pros::Controller& master) {
+    static constexpr pros::controller_digital_e_t buttons[] = {
+        pros::E_CONTROLLER_DIGITAL_L1, pros::E_CONTROLLER_DIGITAL_L2,   pros::E_CONTROLLER_DIGITAL_R1,
+        pros::E_CONTROLLER_DIGITAL_R2, pros::E_CONTROLLER_DIGITAL_A,    pros::E_CONTROLLER_DIGITAL_B,
+        pros::E_CONTROLLER_DIGITAL_X,  pros::E_CONTROLLER_DIGITAL_Y,    pros::E_CONTROLLER_DIGITAL_UP,
+        pros::E_CONTROLLER_DIGITAL_DOWN, pros::E_CONTROLLER_DIGITAL_LEFT, pros::E_CONTROLLER_DIGITAL_RIGHT};
+    uint16_t bits = 0;
+    for (size_t i = 0; i < sizeof(buttons) / sizeof(buttons[0]); i++) {
+        if (master.get_digital(buttons[i])) bits |= 1 << i;
+    }
+    return bits;
+}
+
+HOT_PATH static void recordFrame(pros::Controller& master) {
+    SensorFrame frame;
+    frame.time = pros::millis();
+    frame.rotation = verticalEncoder.get_position();
+    frame.imuRotation[0] = static_cast<float>(imu.get_rotation());
+    frame.imuRotation[1] = static_cast<float>(imu2.get_rotation());
+    frame.imuHeading[0] = static_cast<float>(imu.get_heading());
+    frame.imuHeading[1] = static_cast<float>(imu2.get_heading());
+    // per motor reads, get_position_all() would allocate a vector every frame
+    for (uint8_t i = 0; i < 3; i++) {
+        frame.drivePosition[i] = static_cast<float>(leftMotors.get_position(i));
+        frame.drivePosition[i + 3] = static_cast<float>(rightMotors.get_position(i));
+    }
+    frame.axes[0] = static_cast<int8_t>(master.get_analog(pros::E_CONTROLLER_ANALOG_LEFT_X));
+    frame.axes[1] = static_cast<int8_t>(master.get_analog(pros::E_CONTROLLER_ANALOG_LEFT_Y));
+    frame.axes[2] = static_cast<int8_t>(master.get_analog(pros::E_CONTROLLER_ANALOG_RIGHT_X));
+    frame.axes[3] = static_cast<int8_t>(master.get_analog(pros::E_CONTROLLER_ANALOG_RIGHT_Y));
+    frame.buttons = readButtons(master);
+    lemlib::Pose pose = chassis.getPose();
+    frame.poseX = pose.x;
+    frame.poseY = pose.y;
+    frame.poseTheta = pose.theta;
+
+    uint8_t encoded[sensorMaxFrameSize];
+    if (sdLogger().write(encoded, encodeSensorFrame(frame, encoded))) framesRecorded++;
+}
+
+static void recordSensors() {
+    static pros::Controller master(pros::E_CONTROLLER_MASTER);
+    recordFrame(master);
+}
+
+void startSensorRecording(uint32_t periodMs) { addPeriodicJob("sensor frame", periodMs, 2000, recordSensors); }
+
+uint32_t getSensorFramesRecorded() { return framesRecorded; }
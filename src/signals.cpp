@@ -0,0 +1,157 @@
+#include "main.h"
+#include <algorithm>
+#include "lemlib/api.hpp"
+#define FMT_HEADER_ONLY
+#include "fmt/format.h"
+#include "global.h"
+#include "helpers.h"
+#include "pid_probe.h"
+#include "bounded_buffer.h"
+#include "sd_logger.h"
+#include "dashboard.h"
+#include "lvgl_heap.h"
+#include "task_profiler.h"
+#include "pose_feed.h"
+#include "executor.h"
+#include "alloc_audit.h"
+#include "signals.h"
+
+SignalTable<>& signalTable() {
+    static SignalTable<> table;
+    return table;
+}
+
+// one pose per row: the Pose Feed publishes between signal reads, so pose_x, pose_y and pose_theta
+// read this copy, taken by sampleSignals() just before the row, not latestPose() each
+static PoseSnapshot samplePose;
+
+static float driveTemperatureMax() {
+    double hottest = 0;
+    for (uint8_t i = 0; i < 3; i++) {
+        hottest = std::max({hottest, leftMotors.get_temperature(i), rightMotors.get_temperature(i)});
+    }
+    return static_cast<float>(hottest);
+}
+
+/**
+ * One line per signal. The dashboard picks the ones it shows by name (src/dashboard.cpp)
+ */
+static void registerSignals(SignalTable<>& table) {
+    table.add("pose_x", "in", [] { return samplePose.x; });
+    table.add("pose_y", "in", [] { return samplePose.y; });
+    table.add("pose_theta", "deg", [] { return samplePose.theta; });
+    table.add("imu1_heading", "deg", [] { return static_cast<float>(imu.get_heading()); });
+    table.add("imu2_heading", "deg", [] { return static_cast<float>(imu2.get_heading()); });
+    table.add("imu_heading_avg", "deg",
+              [] { return static_cast<float>(averageImuHeading(imu.get_heading(), imu2.get_heading())); });
+    table.add("rotation_pos", "cdeg", [] { return static_cast<float>(verticalEncoder.get_position()); });
+    table.add("drive_temp_max", "C", driveTemperatureMax);
+    table.add("lateral_pid_error", "in", [] { return chassis.lateralPID.*PidErrorProbe::prevError; });
+    table.add("angular_pid_error", "deg", [] { return chassis.angularPID.*PidErrorProbe::prevError; });
+    table.add("intake_top_temp", "C", [] { return static_cast<float>(intakeTop.get_temperature()); });
+    table.add("intake_bottom_temp", "C", [] { return static_cast<float>(intakeBottom.get_temperature()); });
+    table.add("imu1_orientation", "", [] { return static_cast<float>(imu.get_physical_orientation()); });
+    table.add("imu2_orientation", "", [] { return static_cast<float>(imu2.get_physical_orientation()); });
+    table.add("dash_refresh_us", "us", [] { return static_cast<float>(getDashboardStats().updateMicros); });
+    table.add("dash_render_us", "us", [] { return static_cast<float>(getDashboardStats().renderMicros); });
+    table.add("dash_invalidated_px", "px", [] { return static_cast<float>(getDashboardStats().invalidatedPixels); });
+    table.add("lvgl_heap_used", "B", [] { return static_cast<float>(getLvglHeapStats().usedBytes); });
+    table.add("lvgl_heap_largest_free", "B", [] { return static_cast<float>(getLvglHeapStats().largestFreeBlock); });
+    table.add("lvgl_heap_frag", "%", [] { return static_cast<float>(getLvglHeapStats().fragmentationPct); });
+    table.add("lvgl_alloc_rate", "B/s", [] { return getLvglHeapStats().allocationRate; });
+    table.add("pose_publish_us", "us", [] { return static_cast<float>(getPoseFeedStats().publishMicros); });
+    table.add("heap_allocs", "", [] { return static_cast<float>(getAllocStats().total.allocations); });
+    table.add("alloc_violations", "", [] { return static_cast<float>(getAllocStats().violations); });
+    table.add("deadline_misses", "", [] { return static_cast<float>(getDeadlineMisses()); });
+    table.add("cpu_busy", "%", getCpuBusy);
+    table.add("stack_free_min", "words", [] { return static_cast<float>(getMinStackFree()); });
+}
+
+static void sampleSignals() {
+    samplePose = latestPose();
+    signalTable().sample(pros::millis());
+}
+
+void startSignalSampler(uint32_t periodMs) {
+    SignalTable<>& table = signalTable();
+    if (table.size() == 0) registerSignals(table);
+    addPeriodicJob("signal sample", periodMs, 1500, sampleSignals);
+}
+
+/* OUTPUTS */
+struct SignalOutputState {
+    bool enabled = false;
+    SignalCursor cursor;
+};
+
+static constexpr size_t outputCount = 2;
+static SignalOutputState outputs[outputCount];
+static pros::Mutex outputsMutex;
+
+// "S,time_ms,<names...>" header for csv outputs
+static void formatSignalHeader(fmt::memory_buffer& line) {
+    const SignalTable<>& table = signalTable();
+    line.clear();
+    fmt::format_to(std::back_inserter(line), "S,time_ms");
+    for (size_t i = 0; i < table.size(); i++) {
+        fmt::format_to(std::back_inserter(line), ",{}", table.info(static_cast<SignalId>(i)).name);
+    }
+    line.push_back('\n');
+}
+
+// "S,<time>,<values...>", the S lets csv lines share a stream with other output
+static void formatSignalRow(fmt::memory_buffer& line, uint32_t timeMs, const float* values, size_t count) {
+    line.clear();
+    fmt::format_to(std::back_inserter(line), "S,{}", timeMs);
+    for (size_t i = 0; i < count; i++) fmt::format_to(std::back_inserter(line), ",{:.4g}", values[i]);
+    line.push_back('\n');
+}
+
+// binary frames on the same stream open with their own 0x00, so the line needs no delimiter
+static void writeLine(SignalOutput output, const fmt::memory_buffer& line) {
+    if (output == SignalOutput::SERIAL) boundedStdout().push(line.data(), line.size());
+    else sdLogger().write(line.data(), line.size());
+}
+
+static void consumeSignals() {
+    const SignalTable<>& table = signalTable();
+    fmt::memory_buffer line; // 500 bytes inline, rows never reach the heap
+    float values[SignalTable<>::capacity];
+    uint32_t timeMs;
+    while (true) {
+        for (size_t i = 0; i < outputCount; i++) {
+            SignalOutput output = static_cast<SignalOutput>(i);
+            SignalCursor cursor;
+            {
+                std::lock_guard<pros::Mutex> lock(outputsMutex);
+                if (!outputs[i].enabled) continue;
+                cursor = outputs[i].cursor;
+            }
+            while (table.read(cursor, timeMs, values)) {
+                formatSignalRow(line, timeMs, values, table.size());
+                writeLine(output, line);
+            }
+            std::lock_guard<pros::Mutex> lock(outputsMutex);
+            outputs[i].cursor = cursor;
+        }
+        pros::delay(10);
+    }
+}
+
+void startSignalOutput(SignalOutput output, uint32_t decimation) {
+    static bool consumerStarted = false;
+    fmt::memory_buffer header;
+    formatSignalHeader(header);
+    writeLine(output, header);
+    {
+        std::lock_guard<pros::Mutex> lock(outputsMutex);
+        SignalOutputState& state = outputs[static_cast<size_t>(output)];
+        state.cursor.decimation = decimation;
+        state.cursor.next = signalTable().sampleCount();
+        state.enabled = true;
+    }
+    if (!consumerStarted) {
+        consumerStarted = true;
+        pros::Task consumerTask(consumeSignals, TASK_PRIORITY_MIN + 1, TASK_STACK_DEPTH_DEFAULT, "Signal Outputs");
+    }
+}
@@ -0,0 +1,219 @@
+#include "main.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include "sd_logger.h"
+#include "fast_log.h"
+#include "task_profiler.h"
+#include "executor.h"
+
+// FreeRTOS calls PROS does not wrap or export in its headers, so whether libpros has them is not
+// known at build time. Weak so a kernel without them still links: the address is then null, those
+// columns read -1 and startTaskProfiler() logs a warning. cpu_busy does not depend on them
+extern "C" {
+__attribute__((weak)) unsigned long uxTaskGetStackHighWaterMark(void* task);
+__attribute__((weak)) uint32_t ulTaskGetRunTimeCounter(void* task);
+}
+
+static constexpr size_t maxProfiledTasks = 24;
+
+struct TaskHistory {
+    TaskProfile profile;
+    uint32_t lastRunTime = 0;
+    bool haveRunTime = false;
+    float cpuSum = 0;
+    uint32_t cpuSamples = 0;
+};
+
+static TaskHistory tasks[maxProfiledTasks];
+static size_t taskCount = 0;
+static pros::Mutex tasksMutex;
+static std::atomic<float> cpuBusy = -1;
+static std::atomic<int32_t> minStackFree = -1;
+static std::atomic<uint32_t> kernelTaskCount = 0;
+static uint32_t reportPeriods = 5;
+
+// every task this project starts, plus the kernel's idle task
+static const char* const defaultTasks[] = {
+    "IDLE", "CPU Probe", "Executor", "Pose Feed", "Signal Outputs", "State Sync", "Vision", "Trace Export",
+    "SD Logger", "Fast Logger", "Bounded Buffer",
+};
+
+/* CPU PROBE */
+// cpu_busy is measured against wall time by a task one priority above the kernel's idle task. It
+// spins reading the microsecond clock; a gap between two reads longer than probeGapUs is time some
+// other task or an interrupt had the CPU, whether or not that task is profiled. Every probeSliceUs
+// it sleeps 1 ms so the idle task still runs (FreeRTOS frees deleted tasks there), and that
+// millisecond is left out of the measurement
+static constexpr uint32_t probeSliceUs = 9000;
+static constexpr uint32_t probeGapUs = 10;
+static std::atomic<uint32_t> probeIdleUs = 0; // wraps, only differences are used
+static std::atomic<uint32_t> probeMeasuredUs = 0;
+
+static void cpuProbe() {
+    while (true) {
+        uint32_t sliceStart = static_cast<uint32_t>(pros::micros());
+        uint32_t last = sliceStart;
+        uint32_t idle = 0;
+        while (last - sliceStart < probeSliceUs) {
+            uint32_t now = static_cast<uint32_t>(pros::micros());
+            if (now - last <= probeGapUs) idle += now - last;
+            last = now;
+        }
+        probeIdleUs.fetch_add(idle, std::memory_order_relaxed);
+        probeMeasuredUs.fetch_add(last - sliceStart, std::memory_order_release);
+        pros::delay(1);
+    }
+}
+
+static void sampleCpuBusy() {
+    static uint32_t lastIdle = 0;
+    static uint32_t lastMeasured = 0;
+    uint32_t measured = probeMeasuredUs.load(std::memory_order_acquire);
+    uint32_t idle = probeIdleUs.load(std::memory_order_relaxed);
+    if (measured == lastMeasured) return; // the probe has not finished a slice, e.g. just started
+    // idle can run a slice ahead of measured, hence the clamp
+    float busy = 100 * (1 - static_cast<float>(idle - lastIdle) / static_cast<float>(measured - lastMeasured));
+    cpuBusy = std::clamp(busy, 0.0f, 100.0f);
+    lastIdle = idle;
+    lastMeasured = measured;
+}
+
+void profileTask(const char* name) {
+    std::lock_guard<pros::Mutex> lock(tasksMutex);
+    for (size_t i = 0; i < taskCount; i++) {
+        if (strcmp(tasks[i].profile.name, name) == 0) return;
+    }
+    if (taskCount < maxProfiledTasks) tasks[taskCount++].profile.name = name;
+}
+
+static void sampleTasks() {
+    // run time counter ticks spent in each task since the last sample
+    uint32_t deltas[maxProfiledTasks] = {};
+    uint32_t totalDelta = 0;
+    int32_t stackFloor = -1;
+
+    std::lock_guard<pros::Mutex> lock(tasksMutex);
+    for (size_t i = 0; i < taskCount; i++) {
+        TaskHistory& history = tasks[i];
+        TaskProfile& profile = history.profile;
+        // looked up each time: the competition tasks are deleted and recreated between modes
+        pros::task_t task = pros::c::task_get_by_name(profile.name);
+        profile.found = task != nullptr;
+        if (!profile.found) {
+            profile.state = pros::E_TASK_STATE_INVALID;
+            profile.cpu = -1;
+            history.haveRunTime = false;
+            continue;
+        }
+        profile.priority = pros::c::task_get_priority(task);
+        profile.state = pros::c::task_get_state(task);
+        if (uxTaskGetStackHighWaterMark != nullptr) {
+            profile.stackFreeWords = static_cast<int32_t>(uxTaskGetStackHighWaterMark(task));
+            if (stackFloor < 0 || profile.stackFreeWords < stackFloor) stackFloor = profile.stackFreeWords;
+        }
+        if (ulTaskGetRunTimeCounter != nullptr) {
+            uint32_t runTime = ulTaskGetRunTimeCounter(task);
+            if (history.haveRunTime) {
+                deltas[i] = runTime - history.lastRunTime;
+                totalDelta += deltas[i];
+            }
+            history.lastRunTime = runTime;
+            history.haveRunTime = true;
+        }
+    }
+    minStackFree = stackFloor;
+    kernelTaskCount = pros::c::task_get_count();
+    if (totalDelta == 0) return;
+
+    for (size_t i = 0; i < taskCount; i++) {
+        TaskHistory& history = tasks[i];
+        TaskProfile& profile = history.profile;
+        if (!profile.found) continue;
+        profile.cpu = 100.0f * static_cast<float>(deltas[i]) / static_cast<float>(totalDelta);
+        if (history.cpuSamples == 0 || profile.cpu < profile.cpuMin) profile.cpuMin = profile.cpu;
+        if (history.cpuSamples == 0 || profile.cpu > profile.cpuMax) profile.cpuMax = profile.cpu;
+        history.cpuSum += profile.cpu;
+        history.cpuSamples++;
+        profile.cpuAvg = history.cpuSum / static_cast<float>(history.cpuSamples);
+    }
+}
+
+// "P,time_ms,name,state,priority,stack_free,cpu,cpu_min,cpu_avg,cpu_max" per task, -1 for n/a
+static void logTasks() {
+    uint32_t now = pros::millis();
+    std::lock_guard<pros::Mutex> lock(tasksMutex);
+    for (size_t i = 0; i < taskCount; i++) {
+        const TaskProfile& profile = tasks[i].profile;
+        if (!profile.found) continue;
+        sdLogger().print("P,{},{},{},{},{},{:.1f},{:.1f},{:.1f},{:.1f}\n", now, profile.name,
+                         static_cast<int>(profile.state), profile.priority, profile.stackFreeWords, profile.cpu,
+                         profile.cpuMin, profile.cpuAvg, profile.cpuMax);
+    }
+}
+
+static void profileTasks() {
+    static uint32_t samples = 0;
+    sampleCpuBusy();
+    sampleTasks();
+    if (reportPeriods != 0 && ++samples % reportPeriods == 0) logTasks();
+}
+
+void startTaskProfiler(uint32_t periodMs, uint32_t reportEvery) {
+    for (const char* name : defaultTasks) profileTask(name);
+    reportPeriods = reportEvery;
+    pros::Task probeTask(cpuProbe, TASK_PRIORITY_MIN, TASK_STACK_DEPTH_MIN, "CPU Probe");
+    if (uxTaskGetStackHighWaterMark == nullptr) {
+        fastLogger().warn("task profiler: no uxTaskGetStackHighWaterMark in this kernel, stack columns read -1");
+    }
+    if (ulTaskGetRunTimeCounter == nullptr) {
+        fastLogger().warn("task profiler: no ulTaskGetRunTimeCounter in this kernel, per task cpu columns read -1");
+    }
+    addPeriodicJob("task profile", periodMs, 3000, profileTasks);
+}
+
+size_t getTaskProfiles(TaskProfile* out, size_t capacity) {
+    std::lock_guard<pros::Mutex> lock(tasksMutex);
+    size_t count = taskCount < capacity ? taskCount : capacity;
+    for (size_t i = 0; i < count; i++) out[i] = tasks[i].profile;
+    return count;
+}
+
+float getCpuBusy() { return cpuBusy; }
+
+int32_t getMinStackFree() { return minStackFree; }
+
+static const char* stateName(pros::task_state_e_t state) {
+    switch (state) {
+        case pros::E_TASK_STATE_RUNNING: return "running";
+        case pros::E_TASK_STATE_READY: return "ready";
+        case pros::E_TASK_STATE_BLOCKED: return "blocked";
+        case pros::E_TASK_STATE_SUSPENDED: return "suspended";
+        case pros::E_TASK_STATE_DELETED: return "deleted";
+        default: return "-";
+    }
+}
+
+void printTaskProfiles() {
+    TaskProfile profiles[maxProfiledTasks];
+    size_t count = getTaskProfiles(profiles, maxProfiledTasks);
+    size_t found = 0;
+    printf("%-16s %-9s %4s %10s %6s %6s %6s %6s\n", "task", "state", "prio", "stack free", "cpu%", "min",
+           "avg", "max");
+    for (size_t i = 0; i < count; i++) {
+        const TaskProfile& profile = profiles[i];
+        if (!profile.found) continue;
+        found++;
+        printf("%-16s %-9s %4lu %10ld %6.1f %6.1f %6.1f %6.1f\n", profile.name, stateName(profile.state),
+               static_cast<unsigned long>(profile.priority), static_cast<long>(profile.stackFreeWords),
+               profile.cpu, profile.cpuMin, profile.cpuAvg, profile.cpuMax);
+    }
+    // per task cpu% is a share of the profiled tasks' time; tasks missing here (lemlib's, unnamed ones)
+    // are not in it. cpu busy is against wall time and covers every task
+    printf("profiled %u of %lu tasks, cpu busy %.1f%%, least stack free %ld words%s%s\n",
+           static_cast<unsigned>(found), static_cast<unsigned long>(kernelTaskCount.load()), getCpuBusy(),
+           static_cast<long>(getMinStackFree()),
+           ulTaskGetRunTimeCounter == nullptr ? " (no run time counters in this kernel)" : "",
+           uxTaskGetStackHighWaterMark == nullptr ? " (no stack high water marks in this kernel)" : "");
+}
@@ -0,0 +1,82 @@
+#include "main.h"
+#include <cstdio>
+#include "lemlib/api.hpp"
+#include "global.h"
+#include "telemetry.h"
+#include "sd_logger.h"
+#include "pid_probe.h"
+#include "hot_path.h"
+#include "pose_feed.h"
+#include "executor.h"
+
+/* STATE */
+static pros::Mutex telemetryMutex;
+static pros::Serial* telemetrySerial = nullptr;
+static uint8_t telemetrySeq[8] = {};
+
+static void writeTelemetry(const uint8_t* data, size_t length, void*) {
+    if (telemetrySerial != nullptr) {
+        telemetrySerial->write(const_cast<uint8_t*>(data), length);
+    } else {
+        fwrite(data, 1, length, stdout);
+        fflush(stdout);
+    }
+}
+
+// frames are queued and written in batches by the buffer's task, so a slow link never stalls
+// the sampling task. Old frames are evicted first: for live data the latest sample matters most
+static BoundedBuffer& telemetryBuffer() {
+    static BoundedBuffer buffer(4096, OverflowPolicy::DROP_OLDEST, writeTelemetry);
+    return buffer;
+}
+
+HOT_PATH void sendTelemetry(TelemetryChannel channel, const void* values, uint8_t count) {
+    uint8_t frame[telemetryMaxFrameSize];
+    size_t length;
+    {
+        std::lock_guard<pros::Mutex> lock(telemetryMutex);
+        uint8_t& seq = telemetrySeq[static_cast<uint8_t>(channel) & 7];
+        length = encodeTelemetryFrame(channel, seq++, pros::millis(), values, count, frame);
+    }
+    if (length == 0) return;
+    telemetryBuffer().push(frame, length);
+    // the card keeps every frame at full rate, even when the live link drops some
+    sdLogger().write(frame, length);
+}
+
+BufferStats getTelemetryBufferStats() { return telemetryBuffer().getStats(); }
+
+HOT_PATH static void sampleMotorVoltages(int16_t* out) {
+    // read motors one at a time, get_voltage_all() would allocate a vector every sample
+    for (uint8_t i = 0; i < 3; i++) {
+        out[i] = static_cast<int16_t>(leftMotors.get_voltage(i));
+        out[i + 3] = static_cast<int16_t>(rightMotors.get_voltage(i));
+    }
+}
+
+static void streamTelemetry() {
+    static uint64_t lastStart = pros::micros();
+    uint64_t start = pros::micros();
+
+    PoseSnapshot pose = latestPose();
+    float poseValues[3] = {pose.x, pose.y, pose.theta};
+    sendTelemetry(TelemetryChannel::POSE, poseValues, 3);
+
+    float pidErrors[2] = {chassis.lateralPID.*PidErrorProbe::prevError, chassis.angularPID.*PidErrorProbe::prevError};
+    sendTelemetry(TelemetryChannel::PID_ERROR, pidErrors, 2);
+
+    int16_t voltages[6];
+    sampleMotorVoltages(voltages);
+    sendTelemetry(TelemetryChannel::MOTOR_VOLTAGE, voltages, 6);
+
+    uint64_t end = pros::micros();
+    uint32_t timing[2] = {static_cast<uint32_t>(start - lastStart), static_cast<uint32_t>(end - start)};
+    sendTelemetry(TelemetryChannel::LOOP_TIMING, timing, 2);
+    lastStart = start;
+}
+
+void startTelemetryStream(uint32_t periodMs, pros::Serial* serial) {
+    telemetrySerial = serial;
+    telemetryBuffer().setRate(periodMs);
+    addPeriodicJob("telemetry", periodMs, 1500, streamTelemetry);
+}
@@ -0,0 +1,120 @@
+#include "main.h"
+#include <atomic>
+#include "liblvgl/lvgl.h"
+#define FMT_HEADER_ONLY
+#include "fmt/format.h"
+#include "bounded_buffer.h"
+#include "sd_logger.h"
+#include "trace.h"
+
+static constexpr size_t maxTracedTasks = 16;
+static constexpr size_t traceDepth = 256; // per task, a few exporter periods of a busy loop
+static constexpr size_t chunkSize = 1024;
+static constexpr uint32_t exportPeriodMs = 20;
+
+static TraceRings<maxTracedTasks, traceDepth> rings;
+static std::atomic<bool> recording = false;
+static std::atomic<TraceOutput> traceOutput = TraceOutput::SERIAL;
+static std::atomic<uint32_t> eventCount = 0;
+static std::atomic<uint32_t> noRingDrops = 0;
+
+void traceEvent(TraceType type, const char* name, float value) {
+    if (!recording.load(std::memory_order_relaxed)) return;
+    TraceRing<traceDepth>* ring =
+        rings.ring(reinterpret_cast<uintptr_t>(pros::c::task_get_current()), pros::c::task_get_name(nullptr));
+    if (ring == nullptr) {
+        noRingDrops++;
+        return;
+    }
+    if (ring->tryPush({name, pros::micros(), value, type})) eventCount++;
+}
+
+/* EXPORT */
+// chrome trace json, one object per "T," line. tid is the ring, pid is always the robot
+static void appendEvent(fmt::memory_buffer& chunk, const TraceEvent& event, size_t tid) {
+    auto out = std::back_inserter(chunk);
+    static constexpr char phases[] = {'B', 'E', 'C', 'i'};
+    fmt::format_to(out, "T,{{\"name\":\"{}\",\"ph\":\"{}\",\"ts\":{},\"pid\":1,\"tid\":{}", event.name,
+                   phases[static_cast<size_t>(event.type)], event.time, tid);
+    if (event.type == TraceType::COUNTER) fmt::format_to(out, ",\"args\":{{\"value\":{}}}", event.value);
+    if (event.type == TraceType::INSTANT) fmt::format_to(out, ",\"s\":\"t\"");
+    fmt::format_to(out, "}}\n");
+}
+
+static void appendThreadName(fmt::memory_buffer& chunk, size_t tid, const char* name) {
+    auto out = std::back_inserter(chunk);
+    fmt::format_to(out, "T,{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":{},\"args\":{{\"name\":\"", tid);
+    for (const char* c = name; *c; c++) {
+        if (*c != '"' && *c != '\\') chunk.push_back(*c);
+    }
+    fmt::format_to(out, "\"}}}}\n");
+}
+
+// whole lines at a time, so other output on the stream never lands inside an event
+static void writeChunk(fmt::memory_buffer& chunk) {
+    if (chunk.size() > 0) {
+        if (traceOutput.load() == TraceOutput::SERIAL) boundedStdout().push(chunk.data(), chunk.size());
+        else sdLogger().write(chunk.data(), chunk.size());
+    }
+    chunk.clear();
+}
+
+static void exportTrace() {
+    fmt::memory_buffer chunk;
+    bool named[maxTracedTasks] = {};
+    TraceEvent event;
+    while (true) {
+        for (size_t i = 0; i < rings.size(); i++) {
+            size_t tid = i + 1;
+            const char* name = rings.name(i);
+            if (!named[i] && name != nullptr) {
+                appendThreadName(chunk, tid, name);
+                named[i] = true;
+            }
+            while (rings.at(i).tryPop(event)) {
+                appendEvent(chunk, event, tid);
+                if (chunk.size() >= chunkSize) writeChunk(chunk);
+            }
+        }
+        writeChunk(chunk);
+        pros::delay(exportPeriodMs);
+    }
+}
+
+void startTrace(TraceOutput output) {
+    static bool exporterStarted = false;
+    traceOutput = output;
+    recording = true;
+    if (!exporterStarted) {
+        exporterStarted = true;
+        pros::Task exportTask(exportTrace, TASK_PRIORITY_MIN + 1, TASK_STACK_DEPTH_DEFAULT, "Trace Export");
+    }
+}
+
+void stopTrace() { recording = false; }
+
+/* LVGL */
+static void onDisplayEvent(lv_event_t* e) {
+    switch (lv_event_get_code(e)) {
+        case LV_EVENT_REFR_START: traceEvent(TraceType::BEGIN, "lvgl refresh"); break;
+        case LV_EVENT_RENDER_START: traceEvent(TraceType::BEGIN, "lvgl render"); break;
+        case LV_EVENT_RENDER_READY: traceEvent(TraceType::END, "lvgl render"); break;
+        case LV_EVENT_REFR_READY: traceEvent(TraceType::END, "lvgl refresh"); break;
+        default: break;
+    }
+}
+
+void traceLvglRefresh() {
+    // registered from LVGL's own task, LVGL has no lock in this build
+    lv_async_call([](void*) { lv_display_add_event_cb(lv_display_get_default(), onDisplayEvent, LV_EVENT_ALL, nullptr); },
+                  nullptr);
+}
+
+TraceStats getTraceStats() {
+    TraceStats stats;
+    stats.events = eventCount;
+    stats.dropped = noRingDrops;
+    stats.tasks = static_cast<uint32_t>(rings.size());
+    for (size_t i = 0; i < stats.tasks; i++) stats.dropped += rings.at(i).droppedCount();
+    return stats;
+}
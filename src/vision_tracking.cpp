@@ -0,0 +1,111 @@
+#include "main.h"
+#include <algorithm>
+#include <mutex>
+#include "lemlib/api.hpp"
+#include "pros/ai_vision.hpp"
+#include "global.h"
+#include "vision_tracking.h"
+#include "pose_feed.h"
+
+/* STATE */
+static pros::Mutex visionMutex;
+static ObjectTracker<16, AIVISION_MAX_OBJECT_COUNT>* tracker = nullptr;
+static VisionStats visionStats;
+static bool visionRecording = false;
+
+// fills det from a sensor object, returns false for types the tracker does not follow
+static bool toDetection(const pros::AIVision::Object& object, Detection& det) {
+    if (pros::AIVision::is_type(object, pros::AivisionDetectType::color)) {
+        det = {static_cast<float>(object.object.color.xoffset), static_cast<float>(object.object.color.yoffset),
+               static_cast<float>(object.object.color.width), static_cast<float>(object.object.color.height),
+               object.id};
+        return true;
+    }
+    if (pros::AIVision::is_type(object, pros::AivisionDetectType::object)) {
+        det = {static_cast<float>(object.object.element.xoffset), static_cast<float>(object.object.element.yoffset),
+               static_cast<float>(object.object.element.width), static_cast<float>(object.object.element.height),
+               visionModelClass(object.id)};
+        return true;
+    }
+    return false;
+}
+
+void startVisionTracking(uint8_t port, CameraModel camera, uint32_t periodMs, uint32_t budgetUs) {
+    // sized once here and reused every frame
+    static pros::AIVision sensor(port);
+    static ObjectTracker<16, AIVISION_MAX_OBJECT_COUNT> instance({}, camera);
+    tracker = &instance;
+    visionStats.detectionCap = AIVISION_MAX_OBJECT_COUNT;
+
+    pros::Task visionTask([periodMs, budgetUs]() {
+        Detection detections[AIVISION_MAX_OBJECT_COUNT];
+        uint32_t lastWake = pros::millis();
+        while (true) {
+            uint64_t start = pros::micros();
+            PoseSnapshot pose = latestPose();
+            uint32_t now = pros::millis();
+
+            // read objects one at a time, get_all_objects() allocates a vector per frame
+            int32_t objectCount = std::min<int32_t>(sensor.get_object_count(), AIVISION_MAX_OBJECT_COUNT);
+            size_t count = 0;
+            for (int32_t i = 0; i < objectCount; i++) {
+                if (toDetection(sensor.get_object(i), detections[count])) count++;
+            }
+
+            // held for the tracker update and the stats only, readers never wait out the print or sleep
+            {
+                std::lock_guard<pros::Mutex> lock(visionMutex);
+                if (count > visionStats.detectionCap) {
+                    // over budget last time, keep the largest (closest) objects
+                    std::partial_sort(detections, detections + visionStats.detectionCap, detections + count,
+                                      [](const Detection& a, const Detection& b) {
+                                          return a.width * a.height > b.width * b.height;
+                                      });
+                    count = visionStats.detectionCap;
+                }
+                tracker->update(detections, count, now, pose.x, pose.y, pose.theta);
+
+                uint32_t elapsed = static_cast<uint32_t>(pros::micros() - start);
+                visionStats.frames++;
+                visionStats.lastUs = elapsed;
+                visionStats.maxUs = std::max(visionStats.maxUs, elapsed);
+                if (elapsed > budgetUs) {
+                    visionStats.overBudget++;
+                    visionStats.detectionCap = std::max<uint8_t>(4, visionStats.detectionCap / 2);
+                } else if (elapsed < budgetUs / 2 && visionStats.detectionCap < AIVISION_MAX_OBJECT_COUNT) {
+                    visionStats.detectionCap++;
+                }
+            }
+
+            if (visionRecording) {
+                // a frame with nothing in view still gets a line, the tracker ages its tracks on it
+                if (count == 0) printf("V,%u,%.2f,%.2f,%.2f\n", now, pose.x, pose.y, pose.theta);
+                for (size_t i = 0; i < count; i++) {
+                    const Detection& det = detections[i];
+                    printf("V,%u,%.2f,%.2f,%.2f,%u,%.0f,%.0f,%.0f,%.0f\n", now, pose.x, pose.y, pose.theta,
+                           det.classId, det.x, det.y, det.width, det.height);
+                }
+            }
+
+            pros::Task::delay_until(&lastWake, periodMs);
+        }
+    }, TASK_PRIORITY_DEFAULT - 1, TASK_STACK_DEPTH_DEFAULT, "Vision");
+}
+
+bool getVisionTarget(uint8_t classId, float& x, float& y) {
+    if (tracker == nullptr) return false;
+    PoseSnapshot pose = latestPose();
+    std::lock_guard<pros::Mutex> lock(visionMutex);
+    const Track* track = tracker->nearest(classId, pose.x, pose.y);
+    if (track == nullptr) return false;
+    x = track->fieldX;
+    y = track->fieldY;
+    return true;
+}
+
+VisionStats getVisionStats() {
+    std::lock_guard<pros::Mutex> lock(visionMutex);
+    return visionStats;
+}
+
+void setVisionRecording(bool enabled) { visionRecording = enabled; }
@@ -0,0 +1,173 @@
+/*
+ * Packs a static asset for COMPRESSED_ASSET (see include/compressed_asset.h): splits it into
+ * independent blocks and LZ4-compresses each one. Run by the build for files in COMPRESS_ASSETS.
+ *
+ * build:  g++ -std=c++20 -O2 -Iinclude tools/asset_pack.cpp -o asset_pack
+ * usage:  asset_pack <input> <output.lz4> [block size, default 4096]
+ *         asset_pack --check <output.lz4> <input>    decompress and compare with the original
+ */
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <string_view>
+#include <vector>
+#include "compressed_asset.h"
+
+static bool readFile(const char* path, std::vector<uint8_t>& data) {
+    FILE* file = fopen(path, "rb");
+    if (file == nullptr) {
+        perror(path);
+        return false;
+    }
+    uint8_t chunk[4096];
+    size_t n;
+    while ((n = fread(chunk, 1, sizeof(chunk), file)) > 0) data.insert(data.end(), chunk, chunk + n);
+    fclose(file);
+    return true;
+}
+
+static uint32_t read32(const uint8_t* p) {
+    uint32_t value;
+    std::memcpy(&value, p, 4);
+    return value;
+}
+
+static void put32(std::vector<uint8_t>& out, uint32_t value) {
+    uint8_t bytes[4];
+    std::memcpy(bytes, &value, 4);
+    out.insert(out.end(), bytes, bytes + 4);
+}
+
+static void putLength(std::vector<uint8_t>& out, size_t length) {
+    // the token holds the first 15, then 255s until the remainder
+    for (length -= 15; length >= 255; length -= 255) out.push_back(255);
+    out.push_back(static_cast<uint8_t>(length));
+}
+
+static void putSequence(std::vector<uint8_t>& out, const uint8_t* literals, size_t literalLength, size_t offset,
+                        size_t matchLength) {
+    size_t matchCode = matchLength ? matchLength - 4 : 0;
+    out.push_back(static_cast<uint8_t>((std::min<size_t>(literalLength, 15) << 4) | std::min<size_t>(matchCode, 15)));
+    if (literalLength >= 15) putLength(out, literalLength);
+    out.insert(out.end(), literals, literals + literalLength);
+    if (matchLength == 0) return;
+    out.push_back(static_cast<uint8_t>(offset));
+    out.push_back(static_cast<uint8_t>(offset >> 8));
+    if (matchCode >= 15) putLength(out, matchCode);
+}
+
+/**
+ * Greedy LZ4 block compression with a single-entry hash table, the same scheme as LZ4's fast mode
+ */
+static std::vector<uint8_t> compressBlock(const uint8_t* src, size_t length) {
+    std::vector<uint8_t> out;
+    std::vector<int32_t> table(1 << 14, -1);
+    // format rules: a match starts at least 12 bytes before the end, the last 5 bytes are literals
+    size_t matchLimit = length > 12 ? length - 12 : 0;
+    size_t anchor = 0, i = 0;
+    while (i < matchLimit) {
+        uint32_t sequence = read32(src + i);
+        uint32_t hash = (sequence * 2654435761u) >> 18;
+        int32_t candidate = table[hash];
+        table[hash] = static_cast<int32_t>(i);
+        if (candidate < 0 || i - candidate > 65535 || read32(src + candidate) != sequence) {
+            i++;
+            continue;
+        }
+        size_t matchLength = 4;
+        while (i + matchLength < length - 5 && src[candidate + matchLength] == src[i + matchLength]) matchLength++;
+        putSequence(out, src + anchor, i - anchor, i - candidate, matchLength);
+        i += matchLength;
+        anchor = i;
+    }
+    putSequence(out, src + anchor, length - anchor, 0, 0);
+    return out;
+}
+
+static int check(const char* packPath, const char* originalPath) {
+    std::vector<uint8_t> pack, original;
+    if (!readFile(packPath, pack) || !readFile(originalPath, original)) return 1;
+    CompressedAsset packed(pack.data(), pack.size());
+    asset& unpacked = packed.get();
+    if (unpacked.buf == nullptr || unpacked.size != original.size() ||
+        std::memcmp(unpacked.buf, original.data(), original.size()) != 0) {
+        fprintf(stderr, "%s does not decompress to %s\n", packPath, originalPath);
+        return 1;
+    }
+    // a cut short or corrupt pack must be rejected, each copy sized exactly so a sanitizer build
+    // catches any read past its end
+    size_t stride = std::max<size_t>(1, pack.size() / 512);
+    for (size_t cut = 0; cut < pack.size(); cut += stride) {
+        std::vector<uint8_t> truncated(pack.begin(), pack.begin() + cut);
+        CompressedAsset damaged(truncated.data(), truncated.size());
+        if (damaged.get().buf != nullptr) {
+            fprintf(stderr, "%s cut to %zu bytes still decompresses\n", packPath, cut);
+            return 1;
+        }
+    }
+    for (uint32_t bad : {0x7FFFFFFFu, 0xFFFFFFFFu}) {
+        if (packed.blockCount() == 0) break;
+        std::vector<uint8_t> corrupt = pack;
+        std::memcpy(corrupt.data() + assetPackHeaderSize, &bad, 4); // first block's stored size
+        CompressedAsset badBlock(corrupt.data(), corrupt.size());
+        std::memcpy(corrupt.data() + 12, &bad, 4); // block count
+        CompressedAsset badCount(corrupt.data(), corrupt.size());
+        uint8_t block[64];
+        if (badBlock.get().buf != nullptr || badBlock.readBlock(1, block, sizeof(block)) >= 0 ||
+            badCount.get().buf != nullptr || badCount.readBlock(1, block, sizeof(block)) >= 0) {
+            fprintf(stderr, "%s with a corrupt block table still decompresses\n", packPath);
+            return 1;
+        }
+    }
+    printf("%s: ok, %zu blocks, truncated and corrupt copies rejected\n", packPath, packed.blockCount());
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    if (argc >= 4 && std::string_view(argv[1]) == "--check") return check(argv[2], argv[3]);
+    if (argc < 3) {
+        fprintf(stderr, "usage: %s <input> <output.lz4> [block size]\n       %s --check <output.lz4> <input>\n",
+                argv[0], argv[0]);
+        return 1;
+    }
+    size_t blockSize = argc > 3 ? strtoul(argv[3], nullptr, 10) : 4096;
+    if (blockSize == 0 || blockSize >= assetPackRawBlock) {
+        fprintf(stderr, "bad block size\n");
+        return 1;
+    }
+    std::vector<uint8_t> input;
+    if (!readFile(argv[1], input)) return 1;
+
+    size_t blockCount = (input.size() + blockSize - 1) / blockSize;
+    std::vector<uint8_t> sizes, blocks;
+    for (size_t offset = 0; offset < input.size(); offset += blockSize) {
+        size_t length = std::min(blockSize, input.size() - offset);
+        std::vector<uint8_t> compressed = compressBlock(input.data() + offset, length);
+        if (compressed.size() >= length) {
+            // incompressible, store it as is
+            put32(sizes, static_cast<uint32_t>(length) | assetPackRawBlock);
+            blocks.insert(blocks.end(), input.begin() + offset, input.begin() + offset + length);
+        } else {
+            put32(sizes, static_cast<uint32_t>(compressed.size()));
+            blocks.insert(blocks.end(), compressed.begin(), compressed.end());
+        }
+    }
+
+    std::vector<uint8_t> pack;
+    put32(pack, assetPackMagic);
+    put32(pack, static_cast<uint32_t>(input.size()));
+    put32(pack, static_cast<uint32_t>(blockSize));
+    put32(pack, static_cast<uint32_t>(blockCount));
+    pack.insert(pack.end(), sizes.begin(), sizes.end());
+    pack.insert(pack.end(), blocks.begin(), blocks.end());
+
+    FILE* output = fopen(argv[2], "wb");
+    if (output == nullptr || fwrite(pack.data(), 1, pack.size(), output) != pack.size()) {
+        perror(argv[2]);
+        return 1;
+    }
+    fclose(output);
+    printf("%s: %zu -> %zu bytes (%.0f%%)\n", argv[1], input.size(), pack.size(),
+           input.empty() ? 100.0 : 100.0 * pack.size() / input.size());
+    return 0;
+}
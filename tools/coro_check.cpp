@@ -0,0 +1,151 @@
+/*
+ * Runs coroutine actions (coro.h) through runAction(), the loop auton::run uses, on a simulated
+ * clock and chassis, and checks what they return, how long they take and that every frame is
+ * given back. Build it with the sanitizers on, frame reuse is what it is watching for.
+ *
+ * build:  g++ -std=c++20 -g -fsanitize=address,undefined -Iinclude tools/coro_check.cpp -o coro_check -lpthread
+ * usage:  coro_check
+ *
+ * The chassis is a motion end time: a move waits for the chassis to be idle, starts a motion of
+ * the given length and waits for it to end, like auton::moveToPoint. The killed run case leaves a
+ * run stopped mid-way on a thread that never resumes, as a competition mode change does to the
+ * autonomous task, and checks the next run starts clean.
+ */
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include "coro.h"
+
+static constexpr uint32_t periodMs = 5;
+
+static uint32_t now = 0;
+static uint32_t motionEnd = 0; // the chassis is idle from then
+static uint32_t motions = 0;
+static uint32_t cancelledMotions = 0;
+static uint32_t scoreStarted = 0;
+static bool scoring = false;
+
+static bool chassisIdle() { return timeReached(now, motionEnd); }
+
+static Action move(uint32_t ms) {
+    bool idle = co_await waitUntil(chassisIdle);
+    if (!idle) co_return false;
+    motionEnd = now + ms;
+    motions++;
+    bool ok = co_await waitUntil(chassisIdle);
+    if (!ok) {
+        motionEnd = now;
+        cancelledMotions++;
+    }
+    co_return ok;
+}
+
+static Action score() {
+    scoring = true;
+    scoreStarted = now;
+    bool ok = co_await sleepFor(3000);
+    scoring = false;
+    co_return ok;
+}
+
+// a route like routeAction's: moves and turns in turn, then backing in and scoring together
+static Action route() {
+    for (uint32_t ms : {1000u, 500u, 1000u, 500u}) {
+        bool moved = co_await move(ms);
+        if (!moved) co_return false;
+    }
+    bool ok = co_await whenAll(move(1000), score());
+    co_return ok;
+}
+
+static Action match() {
+    bool ok = co_await route();
+    if (!ok) co_return false;
+    co_await sleepFor(200);
+    ok = co_await route();
+    co_return ok;
+}
+
+static Action matchCutShort() { return withTimeout(match(), 3500); } // during the first route's last move
+
+static void resetWorld() {
+    now = 1000;
+    motionEnd = now;
+    motions = cancelledMotions = scoreStarted = 0;
+    scoring = false;
+}
+
+static void step() {
+    now += periodMs;
+    coroScheduler().tick(now);
+}
+
+static int failures = 0;
+
+static void check(bool ok, const char* what) {
+    printf("%-58s %s\n", what, ok ? "ok" : "FAIL");
+    if (!ok) failures++;
+}
+
+static void checkPoolEmpty(const char* what) {
+    check(framePool().inUse == 0 && framePool().heapFallbacks == 0 && coroScheduler().waiting() == 0, what);
+}
+
+int main() {
+    // one route: the score starts with the last move, so the route takes 3 + 3 s, not 3 + 1 + 3
+    resetWorld();
+    uint32_t start = now;
+    bool ok = runAction(route, now, step);
+    check(ok && now - start <= 6000 + 2 * periodMs * 6, "route finishes with the score overlapping the last move");
+    check(scoreStarted - start <= 3000 + periodMs * 5, "score starts as the last move starts");
+    checkPoolEmpty("route gives back every frame");
+
+    // the whole match, as autonomous() runs it
+    resetWorld();
+    ok = runAction(match, now, step);
+    check(ok && motions == 10 && cancelledMotions == 0, "match finishes every route");
+    checkPoolEmpty("match gives back every frame");
+
+    // a cutoff mid-route cancels the running motion and the score
+    resetWorld();
+    start = now;
+    ok = runAction(matchCutShort, now, step);
+    check(!ok && cancelledMotions == 1 && !scoring && now - start <= 3500 + periodMs * 2, "cutoff cancels the motion and the score");
+    checkPoolEmpty("cut off match gives back every frame");
+
+    // a run stopped for good mid-way, its frames still marked in use
+    resetWorld();
+    static std::mutex mutex;
+    static std::condition_variable stopped;
+    static bool isStopped = false;
+    std::thread killed([&] {
+        uint32_t ticks = 0;
+        runAction(match, now, [&] {
+            if (++ticks == 700) {
+                std::unique_lock<std::mutex> lock(mutex);
+                isStopped = true;
+                stopped.notify_all();
+                stopped.wait(lock, [] { return false; }); // never resumes, like a deleted task
+            }
+            step();
+        });
+    });
+    killed.detach();
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        stopped.wait(lock, [] { return isStopped; });
+    }
+    check(framePool().inUse > 0, "killed run leaves frames in use");
+    resetWorld();
+    ok = runAction(match, now, step);
+    check(ok && motions == 10 && cancelledMotions == 0, "next run starts clean and finishes");
+    checkPoolEmpty("next run gives back every frame");
+
+    printf("frame pool peak %zu of %zu blocks\n", framePool().peak, FramePool::blockCount);
+    printf("%s\n", failures == 0 ? "pass" : "FAIL");
+    fflush(stdout);
+    // the killed run's thread never ends, so leave without running destructors under it
+    std::_Exit(failures == 0 ? 0 : 1);
+}
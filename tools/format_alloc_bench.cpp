@@ -0,0 +1,89 @@
+/*
+ * Counts heap allocations and time per formatted value, comparing lemlib's format_as overloads
+ * (which return std::string) with the formatters in include/lemlib/format.hpp and
+ * include/format_types.h.
+ *
+ * build:  g++ -std=c++20 -O2 -Iinclude tools/format_alloc_bench.cpp -o format_alloc_bench
+ * usage:  format_alloc_bench [iterations]
+ */
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include "format_types.h"
+
+/* ALLOCATION COUNTING */
+static size_t allocations = 0;
+
+void* operator new(size_t size) {
+    allocations++;
+    if (void* p = malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { free(p); }
+
+void operator delete(void* p, size_t) noexcept { free(p); }
+
+/* LEMLIB STAND-INS */
+// liblemlib is built for the brain only. These match its definitions so the old path can run here
+lemlib::Pose::Pose(float x, float y, float theta)
+    : x(x),
+      y(y),
+      theta(theta) {}
+
+std::string lemlib::format_as(const Pose& pose) {
+    return fmt::format("lemlib::Pose {{ x: {}, y: {}, theta: {} }}", pose.x, pose.y, pose.theta);
+}
+
+std::string lemlib::format_as(Level level) { return std::string(levelName(level)); }
+
+/* BENCHMARK */
+template <typename F> static void run(const char* name, size_t iterations, F&& body) {
+    fmt::memory_buffer out;
+    body(out); // warm up, so one-time growth is not counted
+    size_t before = allocations;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; i++) {
+        out.clear();
+        body(out);
+    }
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    printf("%-34s %6.2f allocs/call %8.1f ns/call  \"%.*s\"\n", name,
+           static_cast<double>(allocations - before) / iterations, ns / iterations, static_cast<int>(out.size()),
+           out.data());
+}
+
+int main(int argc, char** argv) {
+    size_t iterations = argc > 1 ? strtoul(argv[1], nullptr, 10) : 100000;
+    volatile float jitter = 0.001f; // keeps the values from being folded at compile time
+    lemlib::Pose pose(12.3456f, -48.25f, 271.5f);
+    lemlib::Message message {"tongue extended", lemlib::Level::WARN, 15230};
+    RobotSyncState state {24.5f, 36.25f, 90, 0x05, 2, {{48, 48}, {60, 24}}};
+
+    printf("%zu iterations\n", iterations);
+    run("pose, format_as", iterations, [&](fmt::memory_buffer& out) {
+        pose.x += jitter;
+        fmt::format_to(std::back_inserter(out), "{}", lemlib::format_as(pose));
+    });
+    run("pose, formatter", iterations, [&](fmt::memory_buffer& out) {
+        pose.x += jitter;
+        fmt::format_to(std::back_inserter(out), "{}", pose);
+    });
+    run("pose {:.2c}, stack buffer", iterations, [&](fmt::memory_buffer& out) {
+        pose.x += jitter;
+        char text[64];
+        std::string_view view = formatInto(text, "{:.2c}", pose);
+        out.append(view.data(), view.data() + view.size());
+    });
+    run("level, format_as", iterations, [&](fmt::memory_buffer& out) {
+        fmt::format_to(std::back_inserter(out), "{}", lemlib::format_as(message.level));
+    });
+    run("level, formatter", iterations,
+        [&](fmt::memory_buffer& out) { fmt::format_to(std::back_inserter(out), "{}", message.level); });
+    run("message {:f}, formatter", iterations,
+        [&](fmt::memory_buffer& out) { fmt::format_to(std::back_inserter(out), "{:f}", message); });
+    run("sync state {:.1}, formatter", iterations,
+        [&](fmt::memory_buffer& out) { fmt::format_to(std::back_inserter(out), "{:.1}", state); });
+    return 0;
+}
@@ -0,0 +1,147 @@
+/*
+ * Host decoder for FastLogger's structured (binary) mode, see include/log_frame.h.
+ *
+ * build:  g++ -std=c++20 -O2 -Iinclude tools/log_decode.cpp -o log_decode
+ * usage:  log_decode <capture.bin> bin/hot.package.elf [bin/cold.package.elf ...]
+ *
+ * Format strings and string arguments are looked up by address in the given ELF files, which
+ * must come from the same build that produced the capture. Telemetry frames and plain text in
+ * the capture are skipped.
+ */
+#include <elf.h>
+#include <cstdio>
+#include <string>
+#include <vector>
+#define FMT_HEADER_ONLY
+#include "fmt/args.h"
+#include "fmt/format.h"
+#include "log_frame.h"
+
+struct Section {
+    uint32_t address;
+    std::vector<uint8_t> data;
+};
+
+static std::vector<Section> sections;
+
+static bool loadElf(const char* path) {
+    FILE* file = fopen(path, "rb");
+    if (file == nullptr) {
+        perror(path);
+        return false;
+    }
+    std::vector<uint8_t> image;
+    uint8_t chunk[65536];
+    size_t read;
+    while ((read = fread(chunk, 1, sizeof(chunk), file)) > 0) image.insert(image.end(), chunk, chunk + read);
+    fclose(file);
+
+    Elf32_Ehdr header;
+    if (image.size() < sizeof(header) || std::memcmp(image.data(), ELFMAG, SELFMAG) != 0
+        || image[EI_CLASS] != ELFCLASS32) {
+        fprintf(stderr, "%s: not a 32 bit ELF file\n", path);
+        return false;
+    }
+    std::memcpy(&header, image.data(), sizeof(header));
+    for (uint16_t i = 0; i < header.e_shnum; i++) {
+        Elf32_Shdr section;
+        size_t offset = header.e_shoff + static_cast<size_t>(i) * header.e_shentsize;
+        if (offset + sizeof(section) > image.size()) break;
+        std::memcpy(&section, image.data() + offset, sizeof(section));
+        // only sections that are loaded onto the brain can hold format strings
+        if (!(section.sh_flags & SHF_ALLOC) || section.sh_type == SHT_NOBITS) continue;
+        if (section.sh_offset + section.sh_size > image.size()) continue;
+        sections.push_back({section.sh_addr, std::vector<uint8_t>(image.begin() + section.sh_offset,
+                                                                  image.begin() + section.sh_offset + section.sh_size)});
+    }
+    return true;
+}
+
+static const char* resolve(uint32_t address) {
+    for (const Section& section : sections) {
+        if (address < section.address || address >= section.address + section.data.size()) continue;
+        const uint8_t* start = section.data.data() + (address - section.address);
+        // the string must be terminated inside the section
+        if (std::memchr(start, 0, section.data.size() - (address - section.address)) == nullptr) return nullptr;
+        return reinterpret_cast<const char*>(start);
+    }
+    return nullptr;
+}
+
+static std::string render(const DecodedLog& log) {
+    const char* format = resolve(log.formatAddress);
+    if (format == nullptr) return fmt::format("<unknown format 0x{:08x}>", log.formatAddress);
+    fmt::dynamic_format_arg_store<fmt::format_context> args;
+    for (uint8_t i = 0; i < log.argCount; i++) {
+        uint64_t bits = log.values[i];
+        switch (log.types[i]) {
+            case LogArgType::BOOL: args.push_back(bits != 0); break;
+            case LogArgType::CHAR: args.push_back(static_cast<char>(bits)); break;
+            case LogArgType::I32:
+            case LogArgType::I64: args.push_back(static_cast<int64_t>(bits)); break;
+            case LogArgType::U32:
+            case LogArgType::U64: args.push_back(bits); break;
+            case LogArgType::F32: {
+                float value;
+                std::memcpy(&value, &bits, sizeof(value));
+                args.push_back(value);
+                break;
+            }
+            case LogArgType::F64: {
+                double value;
+                std::memcpy(&value, &bits, sizeof(value));
+                args.push_back(value);
+                break;
+            }
+            case LogArgType::STR: {
+                const char* text = resolve(static_cast<uint32_t>(bits));
+                args.push_back(std::string(text ? text : "<unknown string>"));
+                break;
+            }
+            case LogArgType::NONE: break;
+        }
+    }
+    try {
+        return fmt::vformat(format, args);
+    } catch (const fmt::format_error& error) {
+        return fmt::format("<{}: \"{}\">", error.what(), format);
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        fprintf(stderr, "usage: %s <capture.bin> <program.elf>...\n", argv[0]);
+        return 1;
+    }
+    for (int i = 2; i < argc; i++) {
+        if (!loadElf(argv[i])) return 1;
+    }
+    FILE* input = fopen(argv[1], "rb");
+    if (input == nullptr) {
+        perror(argv[1]);
+        return 1;
+    }
+
+    static const char* levelNames[] = {"INFO", "DEBUG", "WARN", "ERROR", "FATAL"};
+    size_t decoded = 0, skipped = 0;
+    std::vector<uint8_t> frame;
+    int c;
+    while ((c = fgetc(input)) != EOF) {
+        if (c != 0) {
+            if (frame.size() <= logMaxFrameSize) frame.push_back(static_cast<uint8_t>(c));
+            continue;
+        }
+        DecodedLog log;
+        if (!frame.empty() && frame.size() <= logMaxFrameSize && decodeLogFrame(frame.data(), frame.size(), log)) {
+            uint8_t level = static_cast<uint8_t>(log.level);
+            printf("[%u] %s: %s\n", log.time, level < 5 ? levelNames[level] : "?", render(log).c_str());
+            decoded++;
+        } else if (!frame.empty()) {
+            skipped++;
+        }
+        frame.clear();
+    }
+    fclose(input);
+    fprintf(stderr, "%zu log records decoded, %zu other frames skipped\n", decoded, skipped);
+    return 0;
+}
@@ -0,0 +1,140 @@
+/*
+ * Contention benchmark for the pose feed (include/seqlock.h) against the mutex it replaces.
+ *
+ * build:  g++ -std=c++20 -O2 -Iinclude tools/pose_contention_bench.cpp -o pose_contention_bench -lpthread
+ * usage:  pose_contention_bench [readers, default 4] [seconds per run, default 2]
+ *
+ * One writer publishes a pose snapshot every millisecond, as odometry would; the readers read it
+ * in a tight loop, far harder than any UI task does. For each scheme it reports how long the
+ * writer spent per publish (worst case is what matters: it is time odometry could be late), how
+ * many reads the readers got through, and how many of those saw a torn snapshot.
+ */
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "seqlock.h"
+
+using Clock = std::chrono::steady_clock;
+
+// same layout as PoseSnapshot in include/pose_feed.h, which needs PROS
+struct Snapshot {
+    float x, y, theta, xSpeed, ySpeed, thetaSpeed;
+    bool inMotion;
+    uint32_t timeMs;
+};
+
+// every field derived from n, so a reader can tell a snapshot mixed from two publishes
+static Snapshot makeSnapshot(uint32_t n) {
+    float f = static_cast<float>(n % 100000);
+    return {f, f + 1, f + 2, f + 3, f + 4, f + 5, (n & 1) != 0, n};
+}
+
+static bool consistent(const Snapshot& s) {
+    float f = static_cast<float>(s.timeMs % 100000);
+    return s.x == f && s.y == f + 1 && s.theta == f + 2 && s.xSpeed == f + 3 && s.ySpeed == f + 4 &&
+           s.thetaSpeed == f + 5 && s.inMotion == ((s.timeMs & 1) != 0);
+}
+
+class MutexPose {
+    public:
+        void publish(const Snapshot& value) {
+            std::lock_guard<std::mutex> lock(mutex);
+            snapshot = value;
+        }
+
+        Snapshot read() {
+            std::lock_guard<std::mutex> lock(mutex);
+            return snapshot;
+        }
+    private:
+        std::mutex mutex;
+        Snapshot snapshot = {};
+};
+
+class SeqlockPose {
+    public:
+        void publish(const Snapshot& value) { lock.publish(value); }
+
+        Snapshot read() { return lock.read(); }
+    private:
+        Seqlock<Snapshot> lock;
+};
+
+// no synchronization at all, what reading lemlib's pose from another task amounts to
+class UnguardedPose {
+    public:
+        void publish(const Snapshot& value) {
+            for (size_t i = 0; i < sizeof(Snapshot); i++) {
+                reinterpret_cast<volatile char*>(&snapshot)[i] = reinterpret_cast<const char*>(&value)[i];
+            }
+        }
+
+        Snapshot read() {
+            Snapshot copy;
+            for (size_t i = 0; i < sizeof(Snapshot); i++) {
+                reinterpret_cast<char*>(&copy)[i] = reinterpret_cast<volatile char*>(&snapshot)[i];
+            }
+            return copy;
+        }
+    private:
+        Snapshot snapshot = makeSnapshot(0);
+};
+
+template <typename Scheme> static void run(const char* name, unsigned readerCount, double seconds) {
+    Scheme scheme;
+    scheme.publish(makeSnapshot(0));
+    std::atomic<bool> running = true;
+    std::atomic<uint64_t> reads = 0;
+    std::atomic<uint64_t> torn = 0;
+
+    std::vector<std::thread> readers;
+    for (unsigned r = 0; r < readerCount; r++) {
+        readers.emplace_back([&] {
+            uint64_t localReads = 0;
+            uint64_t localTorn = 0;
+            while (running.load(std::memory_order_relaxed)) {
+                if (!consistent(scheme.read())) localTorn++;
+                localReads++;
+            }
+            reads += localReads;
+            torn += localTorn;
+        });
+    }
+
+    std::vector<double> publishUs;
+    auto next = Clock::now();
+    auto end = next + std::chrono::duration<double>(seconds);
+    for (uint32_t n = 1; next < end; n++) {
+        next += std::chrono::milliseconds(1);
+        std::this_thread::sleep_until(next);
+        auto start = Clock::now();
+        scheme.publish(makeSnapshot(n));
+        publishUs.push_back(std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+    }
+    running = false;
+    for (std::thread& reader : readers) reader.join();
+
+    std::sort(publishUs.begin(), publishUs.end());
+    double sum = 0;
+    for (double us : publishUs) sum += us;
+    printf("%-10s %8.3f %8.3f %9.3f %12.1f %10llu\n", name, sum / publishUs.size(),
+           publishUs[publishUs.size() * 99 / 100], publishUs.back(), reads.load() / seconds / 1e6,
+           static_cast<unsigned long long>(torn.load()));
+}
+
+int main(int argc, char** argv) {
+    unsigned readers = argc > 1 ? static_cast<unsigned>(std::atoi(argv[1])) : 4;
+    double seconds = argc > 2 ? std::atof(argv[2]) : 2;
+    printf("%u readers, 1 kHz writer, %.1f s per scheme\n", readers, seconds);
+    printf("%-10s %8s %8s %9s %12s %10s\n", "scheme", "pub avg", "pub p99", "pub max", "Mreads/s", "torn");
+    printf("%-10s %8s %8s %9s\n", "", "us", "us", "us");
+    run<UnguardedPose>("unguarded", readers, seconds);
+    run<MutexPose>("mutex", readers, seconds);
+    run<SeqlockPose>("seqlock", readers, seconds);
+    return 0;
+}
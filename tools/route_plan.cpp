@@ -0,0 +1,164 @@
+/*
+ * Plans a route across the field (field_layout.h) and prints it as auton steps for auton.cpp.
+ *
+ * build:  g++ -std=c++20 -O2 -Iinclude tools/route_plan.cpp -o route_plan
+ * usage:  route_plan x0 y0 x1 y1 [--radius r] [--speed maxSpeed] [--block x0 y0 x1 y1]...
+ *         route_plan --check
+ *
+ * Coordinates are odometry inches, as in the routes. Each --block adds an obstacle, to try a
+ * route around a lane another robot holds. Prints the planning time (the same code replans on
+ * the robot), a map of the field with the route, and a moveTo() per leg with a timeout to match.
+ *
+ * --check plans routes that have a field element between their ends, starting and ending
+ * tighter than the robot's radius as routes do next to a goal, and fails if any leg passes
+ * through an obstacle.
+ */
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "field_layout.h"
+
+static constexpr size_t maxLegs = 32;
+
+static void usage() {
+    fprintf(stderr, "usage: route_plan x0 y0 x1 y1 [--radius r] [--speed maxSpeed] [--block x0 y0 x1 y1]...\n"
+                    "       route_plan --check\n");
+    exit(1);
+}
+
+// odometry inches, each with a field element in the straight line between its ends
+static constexpr struct {
+    float x0, y0, x1, y1;
+    const char* name;
+} checkRoutes[] = {
+    {-54, 48, -38, 48, "across the left long goal"},
+    {-38, 48, -54, 48, "across the left long goal, back"},
+    {54, 48, 38, 48, "across the right long goal"},
+    {-20, 48, 20, 48, "across the centre goal"},
+    {0, 20, 0, 76, "through the centre goal"},
+    {-62, 0, 62, 96, "corner to corner"},
+};
+
+// true if no point of any leg, sampled every half inch, lies in an obstacle
+static bool legsClear(const PathPlanner& planner, PlanPoint start, const PlanPoint* legs, size_t count) {
+    PlanPoint from = start;
+    for (size_t i = 0; i < count; i++) {
+        float length = std::hypot(legs[i].x - from.x, legs[i].y - from.y);
+        int steps = static_cast<int>(std::ceil(length * 2)) + 1;
+        for (int s = 0; s <= steps; s++) {
+            float x = from.x + (legs[i].x - from.x) * s / steps;
+            float y = from.y + (legs[i].y - from.y) * s / steps;
+            if (planner.clearance(x, y) <= 0) return false;
+        }
+        from = legs[i];
+    }
+    return true;
+}
+
+static int check() {
+    static PathPlanner planner;
+    planner.setField(fieldObstacles, fieldObstacleCount);
+    int failures = 0;
+    for (const auto& route : checkRoutes) {
+        PlanPoint start = {route.x0 + odomOriginX, route.y0 + odomOriginY};
+        PlanPoint goal = {route.x1 + odomOriginX, route.y1 + odomOriginY};
+        PlanPoint legs[maxLegs];
+        size_t count = planner.plan(start, goal, robotRadiusInches, legs, maxLegs);
+        bool ok = count > 0 && legsClear(planner, start, legs, count);
+        printf("%-34s %2zu legs %6.1f in  %s\n", route.name, count, planner.lastStats().length, ok ? "ok" : "FAIL");
+        if (!ok) failures++;
+    }
+    printf("%s\n", failures == 0 ? "pass" : "FAIL");
+    return failures == 0 ? 0 : 1;
+}
+
+// one character per 4 inches, top row is the far wall
+static void printMap(const PathPlanner& planner, PlanPoint start, const PlanPoint* legs, size_t count, float radius) {
+    static constexpr int scale = 4;
+    static constexpr int size = static_cast<int>(PathPlanner::fieldInches) / scale;
+    char map[size][size + 1];
+    for (int row = 0; row < size; row++) {
+        for (int col = 0; col < size; col++) {
+            float clearance = planner.clearance((col + 0.5f) * scale, (size - row - 0.5f) * scale);
+            map[row][col] = clearance <= 0 ? '#' : clearance < radius ? ':' : '.';
+        }
+        map[row][size] = 0;
+    }
+    PlanPoint from = start;
+    for (size_t i = 0; i < count; i++) {
+        float length = std::hypot(legs[i].x - from.x, legs[i].y - from.y);
+        int steps = static_cast<int>(length) + 1;
+        for (int s = 0; s <= steps; s++) {
+            float x = from.x + (legs[i].x - from.x) * s / steps;
+            float y = from.y + (legs[i].y - from.y) * s / steps;
+            int col = static_cast<int>(x / scale);
+            int row = size - 1 - static_cast<int>(y / scale);
+            if (col >= 0 && col < size && row >= 0 && row < size) map[row][col] = '*';
+        }
+        from = legs[i];
+    }
+    for (size_t i = 0; i < count; i++) {
+        int col = static_cast<int>(legs[i].x / scale);
+        int row = size - 1 - static_cast<int>(legs[i].y / scale);
+        if (col >= 0 && col < size && row >= 0 && row < size) map[row][col] = static_cast<char>('1' + i % 9);
+    }
+    int col = static_cast<int>(start.x / scale);
+    int row = size - 1 - static_cast<int>(start.y / scale);
+    if (col >= 0 && col < size && row >= 0 && row < size) map[row][col] = 'S';
+    for (int r = 0; r < size; r++) printf("  %s\n", map[r]);
+    printf("  # obstacle  : too tight for the robot  * route  S start  1-9 leg ends\n\n");
+}
+
+int main(int argc, char** argv) {
+    if (argc == 2 && strcmp(argv[1], "--check") == 0) return check();
+    if (argc < 5) usage();
+    PlanPoint start = {strtof(argv[1], nullptr) + odomOriginX, strtof(argv[2], nullptr) + odomOriginY};
+    PlanPoint goal = {strtof(argv[3], nullptr) + odomOriginX, strtof(argv[4], nullptr) + odomOriginY};
+    float radius = robotRadiusInches;
+    int maxSpeed = 127;
+    FieldRect obstacles[PathPlanner::maxObstacles];
+    size_t obstacleCount = 0;
+    for (size_t i = 0; i < fieldObstacleCount; i++) obstacles[obstacleCount++] = fieldObstacles[i];
+    for (int i = 5; i < argc; i++) {
+        if (strcmp(argv[i], "--radius") == 0 && i + 1 < argc) {
+            radius = strtof(argv[++i], nullptr);
+        } else if (strcmp(argv[i], "--speed") == 0 && i + 1 < argc) {
+            maxSpeed = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--block") == 0 && i + 4 < argc && obstacleCount < PathPlanner::maxObstacles) {
+            float x0 = strtof(argv[++i], nullptr), y0 = strtof(argv[++i], nullptr);
+            float x1 = strtof(argv[++i], nullptr), y1 = strtof(argv[++i], nullptr);
+            obstacles[obstacleCount++] = {x0 + odomOriginX, y0 + odomOriginY, x1 + odomOriginX, y1 + odomOriginY};
+        } else {
+            usage();
+        }
+    }
+
+    static PathPlanner planner; // too big for the stack on the brain, kept the same here
+    auto fieldStart = std::chrono::steady_clock::now();
+    planner.setField(obstacles, obstacleCount);
+    auto planStart = std::chrono::steady_clock::now();
+    PlanPoint legs[maxLegs];
+    size_t count = planner.plan(start, goal, radius, legs, maxLegs);
+    auto end = std::chrono::steady_clock::now();
+    const PlanStats& stats = planner.lastStats();
+    printf("distance field %.0f us, plan %.0f us, %u cells expanded\n",
+           std::chrono::duration<double, std::micro>(planStart - fieldStart).count(),
+           std::chrono::duration<double, std::micro>(end - planStart).count(), stats.expanded);
+    if (count == 0) {
+        printf("no route for a %.1f in radius\n", radius);
+        return 1;
+    }
+    printf("%zu legs, %.1f in\n\n", count, stats.length);
+    printMap(planner, start, legs, count, radius);
+
+    PlanPoint from = start;
+    for (size_t i = 0; i < count; i++) {
+        float length = std::hypot(legs[i].x - from.x, legs[i].y - from.y);
+        printf("  moveTo(%.2f, %.2f, %d, {.maxSpeed=%d}),\n", legs[i].x - odomOriginX, legs[i].y - odomOriginY,
+               legTimeoutMs(length), maxSpeed);
+        from = legs[i];
+    }
+    return 0;
+}
@@ -0,0 +1,286 @@
+/*
+ * Replays sensor frames recorded by src/sensor_recorder.cpp through the odometry models in
+ * include/odom_model.h and compares them with the pose lemlib reported on the robot.
+ *
+ * build:  g++ -std=c++20 -O2 -Iinclude tools/sensor_replay.cpp -o sensor_replay
+ * usage:  sensor_replay <run_NNN.bin> [trajectory.csv]
+ *         sensor_replay --self-test
+ *
+ * Only odometry is replayed. lemlib is only built for the brain, so its motion controllers cannot
+ * run here and the recorded controller inputs are carried in the frames for inspection, not fed
+ * back through any control path; ReferenceOdometry re-implements lemlib's update for this
+ * robot's sensors. Small differences from the recorded pose are expected on real runs: lemlib's
+ * odometry task samples the sensors on its own 10 ms schedule, not at the recorder's instants.
+ * Whenever the recorded pose jumps (setPose, calibrate) the estimators are restarted from it.
+ *
+ * --self-test generates a capture whose recorded poses come from ReferenceOdometry itself, mixed
+ * with text and telemetry frames as on a real card, then replays it twice: the reference model
+ * must reproduce every recorded pose bit for bit, and both replays must agree exactly. That only
+ * shows the replay is faithful, so the reference model is also driven along a straight line and
+ * an arc whose poses are known in closed form, with the wheel sized independently of OdomConfig.
+ */
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <vector>
+#include "odom_model.h"
+
+// a recorded pose moving further than this in one frame was set, not driven
+static constexpr float resetDistance = 6; // inches
+static constexpr float resetAngle = 20; // degrees
+
+struct EstimatorRun {
+    EstimatorRun(const char* name, std::unique_ptr<OdomEstimator> estimator)
+        : name(name),
+          estimator(std::move(estimator)) {}
+
+    const char* name;
+    std::unique_ptr<OdomEstimator> estimator;
+    double sumError = 0;
+    float maxError = 0;
+    float maxHeadingError = 0;
+    double nanoseconds = 0;
+    OdomPose last;
+};
+
+static float headingErrorDeg(float estimateRad, float recordedDeg) {
+    float error = std::fmod(estimateRad * 180 / static_cast<float>(M_PI) - recordedDeg, 360.0f);
+    if (error > 180) error -= 360;
+    if (error < -180) error += 360;
+    return std::fabs(error);
+}
+
+// the sensor frames in a capture; telemetry, log frames and csv lines share the file
+static std::vector<SensorFrame> readFrames(FILE* input, size_t& skipped) {
+    std::vector<SensorFrame> frames;
+    std::vector<uint8_t> data;
+    int c;
+    while ((c = fgetc(input)) != EOF) {
+        if (c != 0) {
+            if (data.size() <= sensorMaxFrameSize) data.push_back(static_cast<uint8_t>(c));
+            continue;
+        }
+        SensorFrame frame;
+        if (!data.empty() && data.size() <= sensorMaxFrameSize && decodeSensorFrame(data.data(), data.size(), frame)) {
+            frames.push_back(frame);
+        } else if (!data.empty()) {
+            skipped++;
+        }
+        data.clear();
+    }
+    return frames;
+}
+
+struct ReplayResult {
+    size_t resets = 0;
+    size_t gaps = 0;
+    size_t updates = 0;
+    size_t exact = 0; // updates where the reference pose matched the recorded one bit for bit
+    std::vector<OdomPose> poses; // the reference model's, one per update
+};
+
+static ReplayResult replay(const std::vector<SensorFrame>& frames, EstimatorRun* runs, size_t runCount,
+                           FILE* trajectory) {
+    ReplayResult result;
+    if (trajectory != nullptr) {
+        fprintf(trajectory, "time_ms,recorded_x,recorded_y,recorded_theta");
+        for (size_t r = 0; r < runCount; r++) {
+            fprintf(trajectory, ",%s_x,%s_y,%s_theta", runs[r].name, runs[r].name, runs[r].name);
+        }
+        fputc('\n', trajectory);
+    }
+    for (size_t r = 0; r < runCount; r++) {
+        runs[r].estimator->reset(frames[0].poseX, frames[0].poseY, frames[0].poseTheta, frames[0]);
+    }
+    for (size_t i = 1; i < frames.size(); i++) {
+        const SensorFrame& previous = frames[i - 1];
+        const SensorFrame& frame = frames[i];
+        if (frame.time - previous.time > 15) result.gaps++;
+        float jump = std::hypot(frame.poseX - previous.poseX, frame.poseY - previous.poseY);
+        if (jump > resetDistance || headingErrorDeg(previous.poseTheta * static_cast<float>(M_PI) / 180, frame.poseTheta) > resetAngle) {
+            for (size_t r = 0; r < runCount; r++) runs[r].estimator->reset(frame.poseX, frame.poseY, frame.poseTheta, frame);
+            result.resets++;
+            continue;
+        }
+        for (size_t r = 0; r < runCount; r++) {
+            EstimatorRun& run = runs[r];
+            auto start = std::chrono::steady_clock::now();
+            run.estimator->update(frame);
+            run.nanoseconds += std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+            run.last = run.estimator->pose();
+            float error = std::hypot(run.last.x - frame.poseX, run.last.y - frame.poseY);
+            run.sumError += error;
+            run.maxError = std::max(run.maxError, error);
+            run.maxHeadingError = std::max(run.maxHeadingError, headingErrorDeg(run.last.theta, frame.poseTheta));
+        }
+        const OdomPose& reference = runs[0].last;
+        float theta = reference.theta * 180 / static_cast<float>(M_PI);
+        if (reference.x == frame.poseX && reference.y == frame.poseY && theta == frame.poseTheta) result.exact++;
+        result.poses.push_back(reference);
+        result.updates++;
+        if (trajectory != nullptr) {
+            fprintf(trajectory, "%u,%.4f,%.4f,%.4f", frame.time, frame.poseX, frame.poseY, frame.poseTheta);
+            for (size_t r = 0; r < runCount; r++) {
+                fprintf(trajectory, ",%.4f,%.4f,%.4f", runs[r].last.x, runs[r].last.y, runs[r].last.theta * 180 / M_PI);
+            }
+            fputc('\n', trajectory);
+        }
+    }
+    return result;
+}
+
+// 20 s of driving arcs at 100 Hz, recorded the way the robot would: the pose in each frame is what
+// ReferenceOdometry (standing in for lemlib) computed from that frame's sensors
+static void writeSyntheticCapture(FILE* output) {
+    OdomConfig config;
+    ReferenceOdometry odometry(config);
+    float distance = 0; // along the tracking wheel, inches
+    float heading = 0; // degrees
+    for (uint32_t i = 0; i < 2000; i++) {
+        float t = i / 100.0f;
+        SensorFrame frame;
+        frame.time = 1000 + i * 10;
+        frame.rotation = static_cast<int32_t>(std::lround(distance / (config.wheelDiameter * static_cast<float>(M_PI)) * 36000));
+        frame.imuRotation[0] = heading;
+        frame.imuRotation[1] = heading * 1.002f + 0.1f;
+        frame.imuHeading[0] = std::fmod(heading + 3600, 360.0f);
+        frame.imuHeading[1] = std::fmod(frame.imuRotation[1] + 3600, 360.0f);
+        for (int m = 0; m < 6; m++) frame.drivePosition[m] = distance * (m < 3 ? 35.0f : 36.0f);
+        frame.axes[1] = static_cast<int8_t>(100 * std::sin(t * 0.5f));
+        frame.axes[2] = static_cast<int8_t>(60 * std::sin(t * 0.9f));
+        frame.buttons = i % 300 < 20 ? SENSOR_BUTTON_R1 : 0;
+        if (i == 0) odometry.reset(0, 0, 0, frame);
+        else odometry.update(frame);
+        OdomPose pose = odometry.pose();
+        frame.poseX = pose.x;
+        frame.poseY = pose.y;
+        frame.poseTheta = pose.theta * 180 / static_cast<float>(M_PI);
+
+        uint8_t encoded[sensorMaxFrameSize];
+        fwrite(encoded, 1, encodeSensorFrame(frame, encoded), output);
+        if (i % 50 == 0) fprintf(output, "S,%u,%.4g,%.4g\n", frame.time, frame.poseX, frame.poseY);
+        if (i % 10 == 0) {
+            uint8_t telemetry[telemetryMaxFrameSize];
+            float values[3] = {frame.poseX, frame.poseY, frame.poseTheta};
+            fwrite(telemetry, 1, encodeTelemetryFrame(TelemetryChannel::POSE, static_cast<uint8_t>(i / 10), frame.time, values, 3, telemetry), output);
+        }
+        distance += (30 + 20 * std::sin(t * 0.5f)) / 100;
+        heading += 90 * std::sin(t * 0.9f) / 100;
+    }
+}
+
+// lemlib::Omniwheel::NEW_2 and the offset src/global.cpp gives the vertical wheel, written out
+// here so a wrong OdomConfig default cannot check against itself
+static constexpr float trackingWheelDiameter = 2.125f; // inches
+static constexpr float trackingWheelOffset = -1; // inches, negative is left of the tracking center
+
+// where the robot is at t along a path, and what its tracking wheel and IMU read there
+struct PathPoint {
+        float travel; // tracking wheel distance, inches
+        float headingDeg;
+        float x;
+        float y;
+};
+
+// drives ReferenceOdometry with its default config along path for t from 0 to 1 in 100 steps,
+// returns the largest distance between its pose and the closed form one
+template <typename Path> static float closedFormError(Path path) {
+    ReferenceOdometry odometry;
+    float worst = 0;
+    for (int i = 0; i <= 100; i++) {
+        PathPoint point = path(i / 100.0f);
+        SensorFrame frame;
+        frame.rotation = static_cast<int32_t>(std::lround(point.travel / (trackingWheelDiameter * static_cast<float>(M_PI)) * 36000));
+        frame.imuRotation[0] = frame.imuRotation[1] = point.headingDeg;
+        if (i == 0) odometry.reset(point.x, point.y, point.headingDeg, frame);
+        else odometry.update(frame);
+        OdomPose pose = odometry.pose();
+        worst = std::max(worst, std::hypot(pose.x - point.x, pose.y - point.y));
+    }
+    return worst;
+}
+
+static int selfTest() {
+    FILE* capture = tmpfile();
+    if (capture == nullptr) {
+        perror("tmpfile");
+        return 1;
+    }
+    writeSyntheticCapture(capture);
+    rewind(capture);
+    size_t skipped = 0;
+    std::vector<SensorFrame> frames = readFrames(capture, skipped);
+    fclose(capture);
+
+    ReplayResult results[2];
+    for (ReplayResult& result : results) {
+        EstimatorRun runs[] = {{"reference (lemlib)", std::make_unique<ReferenceOdometry>()}};
+        result = replay(frames, runs, 1, nullptr);
+    }
+    bool repeatable = results[0].poses.size() == results[1].poses.size() &&
+                      std::memcmp(results[0].poses.data(), results[1].poses.data(),
+                                  results[0].poses.size() * sizeof(OdomPose)) == 0;
+    printf("self test: %zu sensor frames, %zu other chunks skipped, %zu of %zu updates reproduce the recorded "
+           "pose exactly, replays %s\n",
+           frames.size(), skipped, results[0].exact, results[0].updates, repeatable ? "identical" : "differ");
+
+    // 48 in straight at a 30 degree heading
+    float straightError = closedFormError([](float t) {
+        float d = 48 * t;
+        return PathPoint {d, 30, d * std::sin(static_cast<float>(M_PI) / 6), d * std::cos(static_cast<float>(M_PI) / 6)};
+    });
+    // a quarter turn to the right around a 24 in radius centered at (24, 0): the tracking center
+    // moves 24 in per radian, the wheel 1 in left of it rides the outside at 25 in per radian
+    float arcError = closedFormError([](float t) {
+        float theta = static_cast<float>(M_PI) / 2 * t;
+        return PathPoint {(24 - trackingWheelOffset) * theta, theta * 180 / static_cast<float>(M_PI),
+                          24 * (1 - std::cos(theta)), 24 * std::sin(theta)};
+    });
+    printf("closed form: straight line off by %.4f in, arc off by %.4f in\n", straightError, arcError);
+
+    bool ok = frames.size() == 2000 && results[0].resets == 0 && results[0].exact == results[0].updates && repeatable &&
+              straightError < 0.01f && arcError < 0.01f;
+    printf("%s\n", ok ? "pass" : "FAIL");
+    return ok ? 0 : 1;
+}
+
+int main(int argc, char** argv) {
+    if (argc > 1 && std::strcmp(argv[1], "--self-test") == 0) return selfTest();
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s <capture.bin> [trajectory.csv]\n       %s --self-test\n", argv[0], argv[0]);
+        return 1;
+    }
+    FILE* input = fopen(argv[1], "rb");
+    if (input == nullptr) {
+        perror(argv[1]);
+        return 1;
+    }
+    FILE* trajectory = nullptr;
+    if (argc > 2 && (trajectory = fopen(argv[2], "w")) == nullptr) {
+        perror(argv[2]);
+        return 1;
+    }
+
+    size_t skipped = 0;
+    std::vector<SensorFrame> frames = readFrames(input, skipped);
+    fclose(input);
+    if (frames.size() < 2) {
+        fprintf(stderr, "%zu sensor frames found, nothing to replay\n", frames.size());
+        return 1;
+    }
+
+    EstimatorRun runs[] = {{"reference (lemlib)", std::make_unique<ReferenceOdometry>()},
+                           {"dual imu", std::make_unique<DualImuOdometry>()}};
+    ReplayResult result = replay(frames, runs, 2, trajectory);
+    if (trajectory != nullptr) fclose(trajectory);
+
+    printf("%zu sensor frames over %.1f s, %zu other frames skipped, %zu gaps over 15 ms, %zu pose resets\n",
+           frames.size(), (frames.back().time - frames.front().time) / 1000.0, skipped, result.gaps, result.resets);
+    for (auto& run : runs) {
+        printf("%-20s mean error %.3f in, max %.3f in, max heading error %.2f deg, %.0f ns/update\n", run.name,
+               result.updates ? run.sumError / result.updates : 0.0, run.maxError, run.maxHeadingError,
+               result.updates ? run.nanoseconds / result.updates : 0.0);
+    }
+    return 0;
+}
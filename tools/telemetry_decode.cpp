@@ -0,0 +1,99 @@
+/*
+ * Host decoder for the binary telemetry stream (see include/telemetry_protocol.h).
+ *
+ * build:  g++ -std=c++20 -O2 -Iinclude tools/telemetry_decode.cpp -o telemetry_decode
+ * usage:  telemetry_decode <capture.bin> [output prefix]
+ *
+ * Writes one csv per channel (<prefix>_pose.csv, <prefix>_pid_error.csv, ...), each with a
+ * time column followed by the channel's value columns. Text mixed into the capture (e.g.
+ * printf output sharing stdout) is skipped: every frame starts with a 0x00 as well as ending with
+ * one, so text before a frame is a chunk of its own and fails the COBS/CRC checks.
+ */
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+#include "telemetry_protocol.h"
+
+static void writeValue(FILE* file, TelemetryType type, const uint8_t* bytes) {
+    if (type == TelemetryType::F32) {
+        float value;
+        std::memcpy(&value, bytes, 4);
+        fprintf(file, ",%.6g", value);
+    } else if (type == TelemetryType::I16) {
+        int16_t value;
+        std::memcpy(&value, bytes, 2);
+        fprintf(file, ",%d", value);
+    } else {
+        uint32_t value;
+        std::memcpy(&value, bytes, 4);
+        fprintf(file, ",%u", value);
+    }
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s <capture.bin> [output prefix]\n", argv[0]);
+        return 1;
+    }
+    FILE* input = fopen(argv[1], "rb");
+    if (input == nullptr) {
+        perror(argv[1]);
+        return 1;
+    }
+    std::string prefix = argc > 2 ? argv[2] : "telemetry";
+
+    std::map<uint8_t, FILE*> outputs;
+    std::map<uint8_t, uint8_t> lastSeq;
+    size_t frames = 0, text = 0, corrupt = 0, lost = 0;
+    std::vector<uint8_t> frame;
+    int c;
+    int last = 0; // the chunk's last byte, frame stops growing past a frame's length
+    while ((c = fgetc(input)) != EOF) {
+        if (c != 0) {
+            last = c;
+            // anything longer than a valid frame is text or garbage, drop it until the next delimiter
+            if (frame.size() <= telemetryMaxFrameSize) frame.push_back(static_cast<uint8_t>(c));
+            continue;
+        }
+        TelemetrySample sample;
+        if (frame.empty()) continue;
+        if (frame.size() > telemetryMaxFrameSize || !decodeTelemetryFrame(frame.data(), frame.size(), sample)) {
+            // printf and logger lines end in a newline, frames are closed by their 0x00 instead
+            if (last == '\n') text++;
+            else corrupt++;
+            frame.clear();
+            continue;
+        }
+        frame.clear();
+        frames++;
+
+        uint8_t id = static_cast<uint8_t>(sample.channel);
+        const TelemetryChannelInfo* info = telemetryChannelInfo(id);
+        if (lastSeq.count(id)) lost += static_cast<uint8_t>(sample.seq - lastSeq[id] - 1);
+        lastSeq[id] = sample.seq;
+
+        FILE*& output = outputs[id];
+        if (output == nullptr) {
+            std::string path = prefix + "_" + info->name + ".csv";
+            output = fopen(path.c_str(), "w");
+            if (output == nullptr) {
+                perror(path.c_str());
+                return 1;
+            }
+            fprintf(output, "time_ms,%s\n", info->columns);
+        }
+        fprintf(output, "%u", sample.time);
+        size_t size = telemetryTypeSize(info->type);
+        for (uint8_t i = 0; i < sample.count; i++) writeValue(output, info->type, sample.values + i * size);
+        fputc('\n', output);
+    }
+
+    for (auto& [id, output] : outputs) fclose(output);
+    fclose(input);
+    fprintf(stderr,
+            "%zu frames decoded, %zu text chunks skipped, %zu corrupt or non-telemetry (e.g. log) frames, %zu lost "
+            "(sequence gaps)\n",
+            frames, text, corrupt, lost);
+    return 0;
+}
@@ -0,0 +1,56 @@
+/*
+ * Pulls the trace (see include/trace.h) out of a serial capture or SD card run file.
+ *
+ * build:  g++ -std=c++20 -O2 -Iinclude tools/trace_extract.cpp -o trace_extract
+ * usage:  trace_extract <capture.bin> [trace.json]
+ *
+ * The robot sends a "T,{event}" line per event, mixed in with telemetry frames, signal csv lines
+ * and log output. This keeps those lines and writes them as one Chrome trace JSON array, for
+ * ui.perfetto.dev or chrome://tracing.
+ */
+#include <cstdio>
+#include <string>
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s <capture.bin> [trace.json]\n", argv[0]);
+        return 1;
+    }
+    FILE* input = fopen(argv[1], "rb");
+    if (input == nullptr) {
+        perror(argv[1]);
+        return 1;
+    }
+    const char* outputPath = argc > 2 ? argv[2] : "trace.json";
+
+    std::string events;
+    std::string line;
+    size_t count = 0;
+    int c;
+    while ((c = fgetc(input)) != EOF) {
+        // binary frames are 0x00 delimited, text is newline delimited
+        if (c != 0 && c != '\n') {
+            line.push_back(static_cast<char>(c));
+            continue;
+        }
+        if (line.size() > 2 && line.compare(0, 3, "T,{") == 0) {
+            events.append(line, 2, std::string::npos);
+            events.append(",\n");
+            count++;
+        }
+        line.clear();
+    }
+    fclose(input);
+
+    // the last event's comma would make the array invalid
+    while (!events.empty() && (events.back() == '\n' || events.back() == ',')) events.pop_back();
+    FILE* output = fopen(outputPath, "w");
+    if (output == nullptr) {
+        perror(outputPath);
+        return 1;
+    }
+    fprintf(output, "[\n%s\n]\n", events.c_str());
+    fclose(output);
+    fprintf(stderr, "%zu trace events -> %s\n", count, outputPath);
+    return 0;
+}
@@ -0,0 +1,102 @@
+/*
+ * Replays recorded AI Vision detections through the object tracker and times every frame.
+ *
+ * build:  g++ -std=c++20 -O2 -Iinclude tools/tracker_replay.cpp -o tracker_replay
+ * usage:  tracker_replay [recording.txt]
+ *
+ * A recording is the terminal output of a run with setVisionRecording(true); lines that do not
+ * start with "V," are ignored. A line with only the time and pose is a frame with no detections,
+ * replayed so tracks age and drop out as they did on the robot. Without a file, a synthetic
+ * recording of six blocks drifting across the image (with dropouts, and a second with nothing in
+ * view) is generated instead.
+ */
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+#include "object_tracker.h"
+
+struct Frame {
+    uint32_t time;
+    float x, y, theta;
+    std::vector<Detection> detections;
+};
+
+static std::vector<Frame> load(const char* path) {
+    std::vector<Frame> frames;
+    FILE* file = fopen(path, "r");
+    if (file == nullptr) {
+        perror(path);
+        return frames;
+    }
+    char line[256];
+    while (fgets(line, sizeof(line), file)) {
+        uint32_t time;
+        unsigned classId;
+        float x, y, theta;
+        Detection det;
+        int fields = sscanf(line, "V,%u,%f,%f,%f,%u,%f,%f,%f,%f", &time, &x, &y, &theta, &classId, &det.x, &det.y,
+                            &det.width, &det.height);
+        if (fields != 9 && fields != 4) continue;
+        if (frames.empty() || frames.back().time != time) frames.push_back({time, x, y, theta, {}});
+        if (fields == 4) continue; // nothing in view this frame
+        det.classId = static_cast<uint8_t>(classId);
+        frames.back().detections.push_back(det);
+    }
+    fclose(file);
+    return frames;
+}
+
+static std::vector<Frame> synthesize() {
+    std::vector<Frame> frames;
+    for (uint32_t i = 0; i < 3000; i++) {
+        Frame frame {i * 20, 0, 0, i * 0.02f, {}};
+        for (int object = 0; object < 6 && (i < 1000 || i >= 1050); object++) {
+            if ((i + object * 7) % 23 == 0) continue; // dropout
+            float x = std::fmod(40.0f * object + i * (0.5f + object * 0.1f), 320.0f);
+            float y = 100 + 20 * std::sin(i * 0.05f + object);
+            float size = 20 + object * 3;
+            frame.detections.push_back({x, y, size, size, static_cast<uint8_t>(1 + object % 2)});
+        }
+        frames.push_back(frame);
+    }
+    return frames;
+}
+
+int main(int argc, char** argv) {
+    std::vector<Frame> frames = argc > 1 ? load(argv[1]) : synthesize();
+    if (frames.empty()) {
+        fprintf(stderr, "no frames to replay\n");
+        return 1;
+    }
+
+    ObjectTracker<16, 24> tracker;
+    std::vector<double> frameUs;
+    size_t detections = 0, maxTracks = 0, emptyFrames = 0;
+    for (const Frame& frame : frames) {
+        if (frame.detections.empty()) emptyFrames++;
+        auto start = std::chrono::steady_clock::now();
+        tracker.update(frame.detections.data(), frame.detections.size(), frame.time, frame.x, frame.y, frame.theta);
+        auto end = std::chrono::steady_clock::now();
+        frameUs.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+        detections += frame.detections.size();
+        maxTracks = std::max(maxTracks, tracker.size());
+    }
+
+    size_t confirmed = 0;
+    uint16_t highestId = 0;
+    for (size_t i = 0; i < tracker.size(); i++) {
+        if (tracker[i].confirmed()) confirmed++;
+        highestId = std::max(highestId, tracker[i].id);
+    }
+    std::vector<double> sorted = frameUs;
+    std::sort(sorted.begin(), sorted.end());
+    double total = 0;
+    for (double us : frameUs) total += us;
+    printf("%zu frames (%zu empty), %zu detections, %u tracks created, %zu live (%zu confirmed), at most %zu at once\n",
+           frames.size(), emptyFrames, detections, highestId, tracker.size(), confirmed, maxTracks);
+    printf("per frame: avg %.2f us, p50 %.2f us, p99 %.2f us, max %.2f us\n", total / frames.size(),
+           sorted[sorted.size() / 2], sorted[sorted.size() * 99 / 100], sorted.back());
+    return 0;
+}